@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <memory>
+#include <span>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "IoUring.hpp"
+
+namespace sandbox
+{
+
+namespace
+{
+
+int IoUringSetup(unsigned entries, io_uring_params& params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int IoUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, const void* arg, unsigned nrArgs)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+template<typename T>
+T* At(void* base, size_t offset)
+{
+    return reinterpret_cast<T*>(static_cast<uint8_t*>(base) + offset);
+}
+
+} // namespace
+
+std::unique_ptr<IoUring> IoUring::Create(unsigned entries)
+{
+    // only the loop thread ever touches the ring, let the kernel skip the cross-thread task work IPIs
+    io_uring_params params{};
+    params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_COOP_TASKRUN;
+    int fd{ IoUringSetup(entries, params) };
+    if (fd < 0 && errno == EINVAL)
+    {
+        // older kernel
+        params = io_uring_params{};
+        fd = IoUringSetup(entries, params);
+    }
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<IoUring> ring{ new IoUring{} };
+    ring->m_fd = fd;
+
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0)
+    {
+        // pre-5.4 kernels map the CQ ring separately, not worth supporting here
+        errno = ENOSYS;
+        return nullptr;
+    }
+
+    size_t sqSize{ params.sq_off.array + (params.sq_entries * sizeof(unsigned)) };
+    size_t cqSize{ params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe)) };
+    ring->m_ringMemSize = std::max(sqSize, cqSize);
+    ring->m_ringMem = mmap(
+        nullptr, ring->m_ringMemSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING
+    );
+    if (ring->m_ringMem == MAP_FAILED)
+    {
+        ring->m_ringMem = nullptr;
+        return nullptr;
+    }
+
+    ring->m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes{
+        mmap(nullptr, ring->m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES)
+    };
+    if (sqes == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    ring->m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    void* mem{ ring->m_ringMem };
+    ring->m_sqHead = At<unsigned>(mem, params.sq_off.head);
+    ring->m_sqTail = At<unsigned>(mem, params.sq_off.tail);
+    ring->m_sqMask = *At<unsigned>(mem, params.sq_off.ring_mask);
+    ring->m_sqEntries = *At<unsigned>(mem, params.sq_off.ring_entries);
+    ring->m_sqLocalTail = *ring->m_sqTail;
+
+    // SQE i always sits in array slot i, so the indirection array is filled once
+    auto* sqArray{ At<unsigned>(mem, params.sq_off.array) };
+    for (unsigned i{ 0 }; i < ring->m_sqEntries; ++i)
+    {
+        sqArray[i] = i;
+    }
+
+    ring->m_cqHead = At<unsigned>(mem, params.cq_off.head);
+    ring->m_cqTail = At<unsigned>(mem, params.cq_off.tail);
+    ring->m_cqMask = *At<unsigned>(mem, params.cq_off.ring_mask);
+    ring->m_cqes = At<io_uring_cqe>(mem, params.cq_off.cqes);
+
+    return ring;
+}
+
+IoUring::~IoUring()
+{
+    if (m_sqes != nullptr)
+    {
+        munmap(m_sqes, m_sqesSize);
+    }
+    if (m_ringMem != nullptr)
+    {
+        munmap(m_ringMem, m_ringMemSize);
+    }
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+}
+
+io_uring_sqe* IoUring::GetSqe()
+{
+    unsigned head{ std::atomic_ref{ *m_sqHead }.load(std::memory_order_acquire) };
+    if (m_sqLocalTail - head >= m_sqEntries)
+    {
+        return nullptr;
+    }
+
+    auto* sqe{ &m_sqes[m_sqLocalTail & m_sqMask] };
+    *sqe = io_uring_sqe{};
+    ++m_sqLocalTail;
+    return sqe;
+}
+
+int IoUring::Submit(unsigned waitNr)
+{
+    unsigned toSubmit{ m_sqLocalTail - std::atomic_ref{ *m_sqTail }.load(std::memory_order_relaxed) };
+    std::atomic_ref{ *m_sqTail }.store(m_sqLocalTail, std::memory_order_release);
+
+    if (toSubmit == 0 && waitNr == 0)
+    {
+        return 0;
+    }
+
+    return IoUringEnter(m_fd, toSubmit, waitNr, waitNr > 0 ? IORING_ENTER_GETEVENTS : 0);
+}
+
+bool IoUring::RegisterBuffers(std::span<const iovec> bufs)
+{
+    return IoUringRegister(m_fd, IORING_REGISTER_BUFFERS, bufs.data(), static_cast<unsigned>(bufs.size())) == 0;
+}
+
+bool IoUring::RegisterBufRing(io_uring_buf_ring* ring, unsigned entries, uint16_t groupId)
+{
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = entries;
+    reg.bgid = groupId;
+    return IoUringRegister(m_fd, IORING_REGISTER_PBUF_RING, &reg, 1) == 0;
+}
+
+bool IoUring::UnregisterBufRing(uint16_t groupId)
+{
+    io_uring_buf_reg reg{};
+    reg.bgid = groupId;
+    return IoUringRegister(m_fd, IORING_UNREGISTER_PBUF_RING, &reg, 1) == 0;
+}
+
+std::unique_ptr<IoUringBufRing> IoUringBufRing::Create(
+    IoUring& ring, uint16_t groupId, unsigned count, size_t bufferSize
+)
+{
+    std::unique_ptr<IoUringBufRing> bufRing{ new IoUringBufRing{} };
+    bufRing->m_ringMemSize = count * sizeof(io_uring_buf);
+    // the ring itself must be page aligned, anonymous memory is
+    bufRing->m_ringMem =
+        mmap(nullptr, bufRing->m_ringMemSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bufRing->m_ringMem == MAP_FAILED)
+    {
+        bufRing->m_ringMem = nullptr;
+        return nullptr;
+    }
+
+    bufRing->m_uring = &ring;
+    bufRing->m_ring = static_cast<io_uring_buf_ring*>(bufRing->m_ringMem);
+    bufRing->m_storage = std::make_unique<uint8_t[]>(count * bufferSize);
+    bufRing->m_bufferSize = bufferSize;
+    bufRing->m_mask = count - 1;
+    bufRing->m_groupId = groupId;
+
+    if (!ring.RegisterBufRing(bufRing->m_ring, count, groupId))
+    {
+        bufRing->m_uring = nullptr;
+        return nullptr;
+    }
+
+    for (unsigned i{ 0 }; i < count; ++i)
+    {
+        bufRing->Recycle(static_cast<uint16_t>(i));
+    }
+    return bufRing;
+}
+
+IoUringBufRing::~IoUringBufRing()
+{
+    if (m_uring != nullptr)
+    {
+        m_uring->UnregisterBufRing(m_groupId);
+    }
+    if (m_ringMem != nullptr)
+    {
+        munmap(m_ringMem, m_ringMemSize);
+    }
+}
+
+void IoUringBufRing::Recycle(uint16_t bufferId)
+{
+    // not m_ring->bufs, in C++ the kernel header's flexible array member sits behind an empty struct and is misplaced
+    auto& buf{ reinterpret_cast<io_uring_buf*>(m_ring)[m_tail & m_mask] };
+    auto data{ Buffer(bufferId) };
+    buf.addr = reinterpret_cast<uint64_t>(data.data());
+    buf.len = static_cast<uint32_t>(data.size());
+    buf.bid = bufferId;
+
+    // publish the entry before the new tail
+    ++m_tail;
+    std::atomic_ref{ m_ring->tail }.store(m_tail, std::memory_order_release);
+}
+
+} // namespace sandbox
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <memory>
+#include <span>
+#include <sys/uio.h>
+
+namespace sandbox
+{
+
+/**
+Minimal io_uring instance over the raw syscalls: the SQ/CQ rings and the SQE array mapped into the process.
+
+Single-issuer: one thread fills SQEs, submits and reaps completions. GetSqe hands out the next free entry zeroed, Submit
+publishes everything filled since the previous call with one io_uring_enter.
+*/
+
+class IoUring
+{
+public:
+    // nullptr if the kernel refuses the setup, errno is left set
+    static std::unique_ptr<IoUring> Create(unsigned entries);
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    ~IoUring();
+
+    // nullptr when the SQ is full, Submit first
+    io_uring_sqe* GetSqe();
+
+    // Submits the queued SQEs and waits for at least waitNr completions. Returns the io_uring_enter result.
+    int Submit(unsigned waitNr = 0);
+
+    // Invokes fn for every completion already posted and releases them all to the kernel
+    template<typename Fn>
+    size_t ForEachCqe(Fn&& fn)
+    {
+        unsigned head{ std::atomic_ref{ *m_cqHead }.load(std::memory_order_relaxed) };
+        unsigned tail{ std::atomic_ref{ *m_cqTail }.load(std::memory_order_acquire) };
+        size_t n{ tail - head };
+        for (; head != tail; ++head)
+        {
+            fn(m_cqes[head & m_cqMask]);
+        }
+        std::atomic_ref{ *m_cqHead }.store(head, std::memory_order_release);
+        return n;
+    }
+
+    // Registers buffers for the *_FIXED opcodes, buf_index is the position in bufs
+    bool RegisterBuffers(std::span<const iovec> bufs);
+
+    // Registers a provided buffer ring (IORING_REGISTER_PBUF_RING) of entries slots living at ring
+    bool RegisterBufRing(io_uring_buf_ring* ring, unsigned entries, uint16_t groupId);
+
+    bool UnregisterBufRing(uint16_t groupId);
+
+    int Fd() const { return m_fd; }
+
+private:
+    IoUring() = default;
+
+    int m_fd{ -1 };
+
+    void* m_ringMem{ nullptr };
+    size_t m_ringMemSize{ 0 };
+    io_uring_sqe* m_sqes{ nullptr };
+    size_t m_sqesSize{ 0 };
+
+    unsigned* m_sqHead{ nullptr };
+    unsigned* m_sqTail{ nullptr };
+    unsigned m_sqMask{ 0 };
+    unsigned m_sqEntries{ 0 };
+    // SQEs handed out locally, published to *m_sqTail by Submit
+    unsigned m_sqLocalTail{ 0 };
+
+    unsigned* m_cqHead{ nullptr };
+    unsigned* m_cqTail{ nullptr };
+    unsigned m_cqMask{ 0 };
+    io_uring_cqe* m_cqes{ nullptr };
+};
+
+/**
+Provided buffer ring for buffer-select receives, e.g. multishot recv.
+
+count buffers of bufferSize bytes are handed to the kernel up front. A completion names the buffer it filled, which
+stays the caller's until Recycle gives it back, so packets can be parsed in place. Must not outlive its IoUring.
+*/
+
+class IoUringBufRing
+{
+public:
+    // count must be a power of two
+    static std::unique_ptr<IoUringBufRing> Create(IoUring& ring, uint16_t groupId, unsigned count, size_t bufferSize);
+
+    IoUringBufRing(const IoUringBufRing&) = delete;
+    IoUringBufRing& operator=(const IoUringBufRing&) = delete;
+
+    ~IoUringBufRing();
+
+    uint16_t GroupId() const { return m_groupId; }
+
+    std::span<uint8_t> Buffer(uint16_t bufferId) const
+    {
+        return { m_storage.get() + (static_cast<size_t>(bufferId) * m_bufferSize), m_bufferSize };
+    }
+
+    // Hands a buffer back to the kernel
+    void Recycle(uint16_t bufferId);
+
+private:
+    IoUringBufRing() = default;
+
+    IoUring* m_uring{ nullptr };
+    void* m_ringMem{ nullptr };
+    size_t m_ringMemSize{ 0 };
+    io_uring_buf_ring* m_ring{ nullptr };
+    std::unique_ptr<uint8_t[]> m_storage;
+    size_t m_bufferSize{ 0 };
+    unsigned m_mask{ 0 };
+    uint16_t m_tail{ 0 };
+    uint16_t m_groupId{ 0 };
+};
+
+} // namespace sandbox
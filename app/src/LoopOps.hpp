@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sandbox
+{
+
+// What an SQE of the sandbox loop was for, kept in the high half of its user_data
+enum class LoopOp : uint8_t
+{
+    Recv = 1,
+    Send = 2,
+    Timeout = 3,
+};
+
+// The low half carries an index, e.g. the send slot
+constexpr uint64_t MakeUserData(LoopOp op, uint32_t index) { return (static_cast<uint64_t>(op) << 32) | index; }
+
+constexpr LoopOp UserDataOp(uint64_t userData) { return static_cast<LoopOp>(userData >> 32); }
+
+constexpr uint32_t UserDataIndex(uint64_t userData) { return static_cast<uint32_t>(userData); }
+
+} // namespace sandbox
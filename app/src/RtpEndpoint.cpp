@@ -0,0 +1,145 @@
+#include "RtpEndpoint.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <memory>
+#include <span>
+#include <Rtcp/RtcpPacketViews.hpp>
+#include <Rtcp/RtcpParser.hpp>
+#include <Rtp/RtpParser.hpp>
+#include "IoUring.hpp"
+#include "LoopOps.hpp"
+
+namespace sandbox
+{
+
+namespace
+{
+
+// rfc5761#section-4, RTCP packet types occupy 192-223 of the second byte
+constexpr uint8_t s_rtcpTypeFirst{ 192 };
+constexpr uint8_t s_rtcpTypeLast{ 223 };
+
+} // namespace
+
+std::unique_ptr<RtpEndpoint> RtpEndpoint::Create(IoUring& ring, int fd, const RtpEndpointConfig& cfg)
+{
+    std::unique_ptr<RtpEndpoint> endpoint{ new RtpEndpoint{ ring, fd, cfg } };
+    endpoint->m_bufRing = IoUringBufRing::Create(ring, cfg.bufferGroup, cfg.nBuffers, cfg.bufferSize);
+    if (!endpoint->m_bufRing)
+    {
+        return nullptr;
+    }
+    return endpoint;
+}
+
+RtpEndpoint::RtpEndpoint(IoUring& ring, int fd, const RtpEndpointConfig& cfg) :
+    m_ring{ ring },
+    m_fd{ fd },
+    m_cfg{ cfg },
+    m_stats{ 16, cfg.clockRate }
+{
+    m_latencyNs.reserve(cfg.maxSamples);
+}
+
+bool RtpEndpoint::ArmRecv()
+{
+    auto* sqe{ m_ring.GetSqe() };
+    if (sqe == nullptr)
+    {
+        return false;
+    }
+
+    // one SQE keeps producing a completion per datagram, each into a buffer picked from the group
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = m_fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = m_bufRing->GroupId();
+    sqe->user_data = MakeUserData(LoopOp::Recv, 0);
+    m_armed = true;
+    return true;
+}
+
+void RtpEndpoint::OnRecvComplete(const io_uring_cqe& cqe, Clock::time_point now)
+{
+    if ((cqe.flags & IORING_CQE_F_MORE) == 0)
+    {
+        // the kernel ended the multishot, e.g. out of buffers, the loop re-arms it
+        m_armed = false;
+    }
+
+    if ((cqe.flags & IORING_CQE_F_BUFFER) == 0)
+    {
+        ++m_recvErrors;
+        return;
+    }
+
+    auto bufferId{ static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT) };
+    if (cqe.res > 0)
+    {
+        OnDatagram(m_bufRing->Buffer(bufferId).first(static_cast<size_t>(cqe.res)), now);
+    }
+    m_bufRing->Recycle(bufferId);
+}
+
+void RtpEndpoint::OnDatagram(std::span<const uint8_t> datagram, Clock::time_point now)
+{
+    if (datagram.size() >= 2 && datagram[1] >= s_rtcpTypeFirst && datagram[1] <= s_rtcpTypeLast)
+    {
+        auto onSenderReport{ [this, now](const rtp::RtcpSenderReportView& sr) { m_stats.OnSenderReport(sr, now); } };
+        if (rtp::ParseRtcp(datagram, onSenderReport))
+        {
+            ++m_rtcpReceived;
+        }
+        else
+        {
+            ++m_malformed;
+        }
+        return;
+    }
+
+    auto pkt{ rtp::ParseRtp(datagram) };
+    if (!pkt || pkt->payload.size() < sizeof(int64_t))
+    {
+        ++m_malformed;
+        return;
+    }
+
+    ++m_rtpReceived;
+    m_stats.OnRtp(*pkt, now);
+
+    int64_t sendTime{};
+    std::memcpy(&sendTime, pkt->payload.data(), sizeof(sendTime));
+    if (m_latencyNs.size() < m_cfg.maxSamples)
+    {
+        auto latency{ now - Clock::time_point{ Clock::duration{ sendTime } } };
+        m_latencyNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+    }
+}
+
+RtpLatencySummary RtpEndpoint::Latency()
+{
+    if (m_latencyNs.empty())
+    {
+        return {};
+    }
+
+    auto at{ [this](size_t permille)
+             {
+                 auto nth{ m_latencyNs.begin() + static_cast<ptrdiff_t>((m_latencyNs.size() - 1) * permille / 1000) };
+                 std::nth_element(m_latencyNs.begin(), nth, m_latencyNs.end());
+                 return std::chrono::nanoseconds{ *nth };
+             } };
+
+    return RtpLatencySummary{
+        .p50 = at(500),
+        .p99 = at(990),
+        .max = std::chrono::nanoseconds{ *std::max_element(m_latencyNs.begin(), m_latencyNs.end()) },
+    };
+}
+
+} // namespace sandbox
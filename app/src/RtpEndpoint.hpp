@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <memory>
+#include <span>
+#include <vector>
+#include <Rtp/RtpReceiverStats.hpp>
+#include "IoUring.hpp"
+
+namespace sandbox
+{
+
+struct RtpEndpointConfig
+{
+    // provided receive buffers, a power of two
+    unsigned nBuffers{ 4096 };
+    size_t bufferSize{ 2048 };
+    uint16_t bufferGroup{ 0 };
+    uint32_t clockRate{ 90000 };
+    // latency samples kept for the percentiles
+    size_t maxSamples{ 1'000'000 };
+};
+
+struct RtpLatencySummary
+{
+    std::chrono::nanoseconds p50{};
+    std::chrono::nanoseconds p99{};
+    std::chrono::nanoseconds max{};
+};
+
+/**
+Receiving side of the sandbox: one multishot recv on a UDP socket, filling buffers from a provided buffer ring.
+
+Each datagram is parsed straight out of the buffer the kernel filled, as RTP or RTCP by its second byte, then the
+buffer goes back to the ring. RTP feeds receiver statistics and a one-way latency sample taken from the send time the
+generator stamps at the front of the payload, sender reports feed the statistics' LSR.
+*/
+
+class RtpEndpoint
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // nullptr if the buffer ring cannot be set up
+    static std::unique_ptr<RtpEndpoint> Create(IoUring& ring, int fd, const RtpEndpointConfig& cfg);
+
+    // Queues the multishot recv, again whenever the kernel ended it
+    bool ArmRecv();
+
+    void OnRecvComplete(const io_uring_cqe& cqe, Clock::time_point now);
+
+    uint64_t RtpReceived() const { return m_rtpReceived; }
+
+    uint64_t RtcpReceived() const { return m_rtcpReceived; }
+
+    uint64_t Malformed() const { return m_malformed; }
+
+    // Recvs that came back without data, e.g. ENOBUFS while every buffer was out
+    uint64_t RecvErrors() const { return m_recvErrors; }
+
+    bool Armed() const { return m_armed; }
+
+    const rtp::RtpReceiverStats& Stats() const { return m_stats; }
+
+    // Reorders the samples, call once at the end
+    RtpLatencySummary Latency();
+
+private:
+    RtpEndpoint(IoUring& ring, int fd, const RtpEndpointConfig& cfg);
+
+    void OnDatagram(std::span<const uint8_t> datagram, Clock::time_point now);
+
+    IoUring& m_ring;
+    int m_fd;
+    RtpEndpointConfig m_cfg;
+    std::unique_ptr<IoUringBufRing> m_bufRing;
+    rtp::RtpReceiverStats m_stats;
+    std::vector<int64_t> m_latencyNs;
+    uint64_t m_rtpReceived{ 0 };
+    uint64_t m_rtcpReceived{ 0 };
+    uint64_t m_malformed{ 0 };
+    uint64_t m_recvErrors{ 0 };
+    bool m_armed{ false };
+};
+
+} // namespace sandbox
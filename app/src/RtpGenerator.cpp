@@ -0,0 +1,189 @@
+#include "RtpGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <memory>
+#include <sys/uio.h>
+#include <Rtcp/RtcpSenderRr.hpp>
+#include <Rtcp/RtcpWriter.hpp>
+#include <Rtp/RtpHeader.hpp>
+#include <Rtp/RtpPacketizer.hpp>
+#include "IoUring.hpp"
+#include "LoopOps.hpp"
+
+namespace sandbox
+{
+
+namespace
+{
+
+constexpr uint32_t s_videoClockRate{ 90000 };
+
+// seconds from 1900-01-01 (NTP era 0) to the unix epoch
+constexpr uint64_t s_ntpUnixOffset{ 2'208'988'800 };
+
+// 64-bit NTP timestamp, seconds in the high half and the fraction in the low one
+uint64_t ToNtp(std::chrono::system_clock::time_point time)
+{
+    auto ns{
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count())
+    };
+    constexpr uint64_t nsPerSec{ 1'000'000'000 };
+    uint64_t secs{ (ns / nsPerSec) + s_ntpUnixOffset };
+    uint64_t frac{ ((ns % nsPerSec) << 32) / nsPerSec };
+    return (secs << 32) | frac;
+}
+
+} // namespace
+
+std::unique_ptr<RtpGenerator> RtpGenerator::Create(IoUring& ring, int fd, const RtpGeneratorConfig& cfg)
+{
+    std::unique_ptr<RtpGenerator> generator{ new RtpGenerator{ ring, fd, cfg } };
+
+    const iovec slab{ .iov_base = generator->m_slab.get(), .iov_len = generator->m_cfg.slots * s_slotSize };
+    if (!ring.RegisterBuffers({ &slab, 1 }))
+    {
+        return nullptr;
+    }
+    return generator;
+}
+
+RtpGenerator::RtpGenerator(IoUring& ring, int fd, const RtpGeneratorConfig& cfg) :
+    m_ring{ ring },
+    m_fd{ fd },
+    m_cfg{ cfg },
+    m_rtpClock{ s_videoClockRate },
+    m_slab{ std::make_unique<uint8_t[]>(static_cast<size_t>(cfg.slots) * s_slotSize) },
+    m_slotIsSr(cfg.slots, false),
+    // 0 disables sender reports
+    m_nextSrAt{ cfg.srInterval > 0 ? cfg.srInterval : UINT64_MAX }
+{
+    // room for the header and the send time stamped at the front of the payload
+    m_cfg.payloadSize = std::clamp(m_cfg.payloadSize, sizeof(int64_t), s_slotSize - sizeof(rtp::RptHeader));
+    m_cfg.batch = std::max<size_t>(m_cfg.batch, 1);
+
+    m_freeSlots.reserve(m_cfg.slots);
+    for (uint32_t slot{ m_cfg.slots }; slot > 0; --slot)
+    {
+        m_freeSlots.push_back(slot - 1);
+    }
+}
+
+RtpGenerator::Clock::time_point RtpGenerator::NextDue() const
+{
+    if (m_cfg.rate == 0 || m_rtpQueued == 0)
+    {
+        return m_start;
+    }
+
+    return m_start + std::chrono::duration_cast<Clock::duration>(
+                         std::chrono::duration<double>{ static_cast<double>(m_rtpQueued) / m_cfg.rate }
+                     );
+}
+
+size_t RtpGenerator::QueueSends(Clock::time_point now)
+{
+    if (m_rtpQueued == 0)
+    {
+        m_start = now;
+    }
+
+    size_t nQueued{ 0 };
+    while (nQueued < m_cfg.batch && !AllQueued() && !m_freeSlots.empty() && NextDue() <= now)
+    {
+        if (m_rtpQueued >= m_nextSrAt && m_freeSlots.size() >= 2)
+        {
+            auto* sqe{ m_ring.GetSqe() };
+            if (sqe == nullptr)
+            {
+                break;
+            }
+
+            uint32_t srSlot{ m_freeSlots.back() };
+            PrepWrite(*sqe, srSlot, BuildSenderReport(srSlot, now));
+            m_slotIsSr[srSlot] = true;
+            m_nextSrAt += m_cfg.srInterval;
+            ++nQueued;
+        }
+
+        auto* sqe{ m_ring.GetSqe() };
+        if (sqe == nullptr)
+        {
+            break;
+        }
+
+        uint32_t slot{ m_freeSlots.back() };
+        PrepWrite(*sqe, slot, BuildRtp(slot, now));
+        m_slotIsSr[slot] = false;
+        ++m_rtpQueued;
+        ++nQueued;
+    }
+
+    return nQueued;
+}
+
+void RtpGenerator::OnSendComplete(const io_uring_cqe& cqe)
+{
+    uint32_t slot{ UserDataIndex(cqe.user_data) };
+    m_freeSlots.push_back(slot);
+
+    if (cqe.res < 0)
+    {
+        ++m_sendErrors;
+    }
+    else if (m_slotIsSr[slot])
+    {
+        ++m_srSent;
+    }
+    else
+    {
+        ++m_rtpSent;
+    }
+}
+
+size_t RtpGenerator::BuildRtp(uint32_t slot, Clock::time_point now)
+{
+    uint8_t* data{ SlotData(slot) };
+    auto& header{ *reinterpret_cast<rtp::RptHeader*>(data) };
+    rtp::FillRtpHeader(header, m_cfg.payloadType, false, m_seq++, m_rtpClock.ToRtp(now), m_cfg.ssrc);
+
+    // the receiver runs in the same process, so the steady clock reading is comparable there
+    int64_t sendTime{ now.time_since_epoch().count() };
+    std::memcpy(data + sizeof(rtp::RptHeader), &sendTime, sizeof(sendTime));
+
+    m_octetsQueued += m_cfg.payloadSize;
+    return sizeof(rtp::RptHeader) + m_cfg.payloadSize;
+}
+
+size_t RtpGenerator::BuildSenderReport(uint32_t slot, Clock::time_point now)
+{
+    rtp::RtcpSenderReportHeader header{};
+    header.ssrc = m_cfg.ssrc;
+    uint64_t ntp{ ToNtp(std::chrono::system_clock::now()) };
+    header.ntpTimestampMsb = static_cast<uint32_t>(ntp >> 32);
+    header.ntpTimestampLsb = static_cast<uint32_t>(ntp);
+    header.rtpTimestamp = m_rtpClock.ToRtp(now);
+    header.senderPktCnt = static_cast<uint32_t>(m_rtpQueued);
+    header.senderOctetCnt = static_cast<uint32_t>(m_octetsQueued);
+
+    rtp::RtcpWriter writer{ { SlotData(slot), s_slotSize } };
+    writer.WriteSenderReport(header, {});
+    return writer.Size();
+}
+
+void RtpGenerator::PrepWrite(io_uring_sqe& sqe, uint32_t slot, size_t size)
+{
+    // a write on a connected UDP socket sends one datagram, and WRITE_FIXED reads it from the registered slab
+    sqe.opcode = IORING_OP_WRITE_FIXED;
+    sqe.fd = m_fd;
+    sqe.addr = reinterpret_cast<uint64_t>(SlotData(slot));
+    sqe.len = static_cast<uint32_t>(size);
+    sqe.buf_index = 0;
+    sqe.user_data = MakeUserData(LoopOp::Send, slot);
+    m_freeSlots.pop_back();
+}
+
+} // namespace sandbox
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <memory>
+#include <vector>
+#include <Rtp/RtpPacketizer.hpp>
+#include "IoUring.hpp"
+
+namespace sandbox
+{
+
+struct RtpGeneratorConfig
+{
+    uint64_t packets{ 1'000'000 };
+    // packets per second, 0 sends as fast as the send slots allow
+    uint64_t rate{ 0 };
+    size_t payloadSize{ 1000 };
+    uint32_t ssrc{ 0x5EED };
+    uint8_t payloadType{ 96 };
+    // most sends queued per io_uring_enter
+    size_t batch{ 32 };
+    // registered send slots, bounds the sends in flight
+    uint32_t slots{ 256 };
+    // one SR per srInterval RTP packets, 0 for none
+    uint64_t srInterval{ 1000 };
+};
+
+/**
+Loopback traffic source: RTP packets carrying their send time, with a sender report every srInterval packets.
+
+Packets are built in place in a slab registered with the ring and sent with IORING_OP_WRITE_FIXED on a connected UDP
+socket, a batch of SQEs per submit. A slot is reused once its send completed.
+*/
+
+class RtpGenerator
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Largest datagram a send slot holds
+    static constexpr size_t s_slotSize{ 1500 };
+
+    // nullptr if the slab cannot be registered
+    static std::unique_ptr<RtpGenerator> Create(IoUring& ring, int fd, const RtpGeneratorConfig& cfg);
+
+    // Queues the packets due at now, at most one batch. Returns the number of SQEs queued.
+    size_t QueueSends(Clock::time_point now);
+
+    void OnSendComplete(const io_uring_cqe& cqe);
+
+    // When the next packet is due with pacing, now without
+    Clock::time_point NextDue() const;
+
+    bool AllQueued() const { return m_rtpQueued == m_cfg.packets; }
+
+    // No send in flight
+    bool Idle() const { return m_freeSlots.size() == m_cfg.slots; }
+
+    bool Done() const { return AllQueued() && Idle(); }
+
+    uint64_t RtpSent() const { return m_rtpSent; }
+
+    uint64_t SrSent() const { return m_srSent; }
+
+    uint64_t SendErrors() const { return m_sendErrors; }
+
+private:
+    RtpGenerator(IoUring& ring, int fd, const RtpGeneratorConfig& cfg);
+
+    uint8_t* SlotData(uint32_t slot) { return m_slab.get() + (static_cast<size_t>(slot) * s_slotSize); }
+
+    // Fills slot with the next RTP packet, returns its size
+    size_t BuildRtp(uint32_t slot, Clock::time_point now);
+
+    size_t BuildSenderReport(uint32_t slot, Clock::time_point now);
+
+    // Sends slot, taking it off the free list
+    void PrepWrite(io_uring_sqe& sqe, uint32_t slot, size_t size);
+
+    IoUring& m_ring;
+    int m_fd;
+    RtpGeneratorConfig m_cfg;
+    rtp::RtpClock m_rtpClock;
+    std::unique_ptr<uint8_t[]> m_slab;
+    std::vector<uint32_t> m_freeSlots;
+    // which slots hold an SR, so their completion is not counted as RTP
+    std::vector<bool> m_slotIsSr;
+    Clock::time_point m_start{};
+    uint64_t m_nextSrAt;
+    uint64_t m_rtpQueued{ 0 };
+    uint64_t m_rtpSent{ 0 };
+    uint64_t m_srSent{ 0 };
+    uint64_t m_octetsQueued{ 0 };
+    uint64_t m_sendErrors{ 0 };
+    uint16_t m_seq{ 0 };
+};
+
+} // namespace sandbox
@@ -1,12 +1,245 @@
-#include <Rtcp/RtcpParser.hpp>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <Rtcp/RtcpMetrics.hpp>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
+#include "IoUring.hpp"
+#include "LoopOps.hpp"
+#include "RtpEndpoint.hpp"
+#include "RtpGenerator.hpp"
 
-int main()
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int s_socketBufferSize{ 8 << 20 };
+constexpr unsigned s_ringEntries{ 1024 };
+// how long to keep reaping after the last send completed, for datagrams still in the socket
+constexpr auto s_drainTimeout{ std::chrono::milliseconds{ 200 } };
+
+// Loopback UDP socket with a large buffer, bound to an ephemeral port
+int OpenUdpSocket()
+{
+    int fd{ socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0) };
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &s_socketBufferSize, sizeof(s_socketBufferSize));
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &s_socketBufferSize, sizeof(s_socketBufferSize));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool ConnectTo(int fd, int peerFd)
+{
+    sockaddr_in addr{};
+    socklen_t addrLen{ sizeof(addr) };
+    if (getsockname(peerFd, reinterpret_cast<sockaddr*>(&addr), &addrLen) != 0)
+    {
+        return false;
+    }
+    return connect(fd, reinterpret_cast<const sockaddr*>(&addr), addrLen) == 0;
+}
+
+template<typename T>
+T ArgOr(int argc, char** argv, int idx, T fallback)
+{
+    if (idx >= argc)
+    {
+        return fallback;
+    }
+
+    std::string_view arg{ argv[idx] };
+    T val{};
+    auto res{ std::from_chars(arg.data(), arg.data() + arg.size(), val) };
+    return res.ec == std::errc{} ? val : fallback;
+}
+
+// Bounds the next wait when no completion is otherwise guaranteed to arrive, e.g. while pacing
+void QueueTimeout(sandbox::IoUring& ring, __kernel_timespec& ts, Clock::duration wait)
+{
+    auto* sqe{ ring.GetSqe() };
+    if (sqe == nullptr)
+    {
+        return;
+    }
+
+    auto ns{ std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count() };
+    ts.tv_sec = ns / 1'000'000'000;
+    ts.tv_nsec = ns % 1'000'000'000;
+    sqe->opcode = IORING_OP_TIMEOUT;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uint64_t>(&ts);
+    sqe->len = 1;
+    sqe->user_data = sandbox::MakeUserData(sandbox::LoopOp::Timeout, 0);
+}
+
+} // namespace
+
+// rtp-sandbox [packets] [rate pkt/s, 0 unpaced] [payload bytes]
+int main(int argc, char** argv)
 {
     spdlog::set_default_logger(spdlog::stdout_color_mt("def"));
-    spdlog::info("starting");
 
-    auto res{ rtp::ParseRtcp({ 0x80, 0x00, 0x00, 0x00 }) };
-    spdlog::info("{}", res.at(0).index());
+    sandbox::RtpGeneratorConfig genCfg{};
+    genCfg.packets = ArgOr<uint64_t>(argc, argv, 1, genCfg.packets);
+    genCfg.rate = ArgOr<uint64_t>(argc, argv, 2, genCfg.rate);
+    genCfg.payloadSize = ArgOr<size_t>(argc, argv, 3, genCfg.payloadSize);
+
+    int rxFd{ OpenUdpSocket() };
+    int txFd{ OpenUdpSocket() };
+    if (rxFd < 0 || txFd < 0 || !ConnectTo(txFd, rxFd))
+    {
+        spdlog::error("socket setup failed: {}", std::strerror(errno));
+        return 1;
+    }
+
+    auto ring{ sandbox::IoUring::Create(s_ringEntries) };
+    if (!ring)
+    {
+        spdlog::error("io_uring setup failed: {}", std::strerror(errno));
+        return 1;
+    }
+
+    auto endpoint{ sandbox::RtpEndpoint::Create(*ring, rxFd, sandbox::RtpEndpointConfig{}) };
+    auto generator{ sandbox::RtpGenerator::Create(*ring, txFd, genCfg) };
+    if (!endpoint || !generator)
+    {
+        spdlog::error("buffer registration failed: {}", std::strerror(errno));
+        return 1;
+    }
+
+    spdlog::info(
+        "sending {} packets of {} bytes at {} pkt/s over loopback",
+        genCfg.packets,
+        genCfg.payloadSize,
+        genCfg.rate == 0 ? "max" : std::to_string(genCfg.rate)
+    );
+
+    __kernel_timespec timeoutTs{};
+    bool timeoutArmed{ false };
+    auto start{ Clock::now() };
+    auto lastRecv{ start };
+
+    while (true)
+    {
+        auto now{ Clock::now() };
+        if (!endpoint->Armed())
+        {
+            endpoint->ArmRecv();
+        }
+        generator->QueueSends(now);
+
+        if (generator->Done())
+        {
+            bool allIn{ endpoint->RtpReceived() == generator->RtpSent() &&
+                        endpoint->RtcpReceived() == generator->SrSent() };
+            if (allIn || now - std::max(lastRecv, start) > s_drainTimeout)
+            {
+                break;
+            }
+        }
+
+        // with sends in flight their completions wake the loop, otherwise only a timeout is sure to
+        if (generator->Idle() && !timeoutArmed)
+        {
+            auto wait{ generator->AllQueued() ? Clock::duration{ std::chrono::milliseconds{ 10 } }
+                                              : std::max(generator->NextDue() - now, Clock::duration{}) };
+            QueueTimeout(*ring, timeoutTs, wait);
+            timeoutArmed = true;
+        }
+
+        int res{ ring->Submit(1) };
+        if (res < 0 && errno != EINTR && errno != EBUSY)
+        {
+            spdlog::error("io_uring_enter failed: {}", std::strerror(errno));
+            return 1;
+        }
+
+        now = Clock::now();
+        ring->ForEachCqe(
+            [&](const io_uring_cqe& cqe)
+            {
+                switch (sandbox::UserDataOp(cqe.user_data))
+                {
+                    case sandbox::LoopOp::Recv:
+                        endpoint->OnRecvComplete(cqe, now);
+                        lastRecv = cqe.res > 0 ? now : lastRecv;
+                        break;
+                    case sandbox::LoopOp::Send:
+                        generator->OnSendComplete(cqe);
+                        break;
+                    case sandbox::LoopOp::Timeout:
+                        timeoutArmed = false;
+                        break;
+                }
+            }
+        );
+    }
+
+    auto elapsed{ std::chrono::duration<double>(Clock::now() - start).count() };
+    auto latency{ endpoint->Latency() };
+    auto toUs{ [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1000.0; } };
+
+    spdlog::info(
+        "rtp sent {} received {} lost {}, sr sent {} received {}, malformed {}, send errors {}, recv errors {}",
+        generator->RtpSent(),
+        endpoint->RtpReceived(),
+        generator->RtpSent() - std::min(generator->RtpSent(), endpoint->RtpReceived()),
+        generator->SrSent(),
+        endpoint->RtcpReceived(),
+        endpoint->Malformed(),
+        generator->SendErrors(),
+        endpoint->RecvErrors()
+    );
+    spdlog::info(
+        "{:.3f}s, {:.0f} pkt/s, latency p50 {:.1f}us p99 {:.1f}us max {:.1f}us",
+        elapsed,
+        static_cast<double>(endpoint->RtpReceived()) / elapsed,
+        toUs(latency.p50),
+        toUs(latency.p99),
+        toUs(latency.max)
+    );
+
+    auto metrics{ rtp::SnapshotRtcpMetrics() };
+    const auto& srLatency{ metrics.latency[rtp::RtcpMetricsTypeIdx(rtp::RtcpType::SenderRR)] };
+    spdlog::info(
+        "rtcp compounds {}, sr parsed {}, dropped truncated {} bad version {} length {} unknown {} malformed {}, "
+        "sr parse p50 <{}ns p99 <{}ns over {} samples",
+        metrics.compounds,
+        metrics.parsed[rtp::RtcpMetricsTypeIdx(rtp::RtcpType::SenderRR)],
+        metrics.Drops(rtp::RtcpDrop::Truncated),
+        metrics.Drops(rtp::RtcpDrop::BadVersion),
+        metrics.Drops(rtp::RtcpDrop::LengthOverrun),
+        metrics.Drops(rtp::RtcpDrop::UnknownType),
+        metrics.Drops(rtp::RtcpDrop::Malformed),
+        srLatency.Quantile(0.5).count(),
+        srLatency.Quantile(0.99).count(),
+        srLatency.Count()
+    );
+
+    close(txFd);
+    close(rxFd);
 }
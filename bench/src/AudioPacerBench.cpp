@@ -0,0 +1,75 @@
+#include <array>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BenchUtil.hpp"
+#include "Common/PacketBufferPool.hpp"
+#include "Rtp/RtpAudioPacketizer.hpp"
+#include "Rtp/RtpPacer.hpp"
+
+namespace rtp::bench
+{
+
+namespace
+{
+
+constexpr auto s_frameInterval{ std::chrono::milliseconds{ 20 } };
+
+// 20 ms CELT fullband frame, config 31 code 0
+std::array<uint8_t, 80> MakeOpusFrame()
+{
+    std::array<uint8_t, 80> frame{};
+    frame[0] = 31 << 3;
+    return frame;
+}
+
+// state.range(0) streams, each sending a 20 ms Opus frame per interval. One iteration runs one interval of 1 ms
+// ticks, every stream firing once: the frame is written into a pooled buffer, released as if sent, and the stream
+// rescheduled from its media time.
+void BM_AudioPacerInterval(benchmark::State& state)
+{
+    auto nStreams{ static_cast<uint32_t>(state.range(0)) };
+    auto frame{ MakeOpusFrame() };
+    PacketBufferPool pool{ 64 };
+    PacketBufferCache cache{ pool };
+
+    auto start{ RtpPacer::Clock::time_point{} };
+    RtpPacer pacer{ RtpPacerConfig{ .streams = nStreams }, start };
+    std::vector<RtpAudioPacketizer> streams{};
+    std::vector<RtpPacer::Clock::time_point> streamStarts{};
+    for (uint32_t id{ 0 }; id < nStreams; ++id)
+    {
+        streams.emplace_back(RtpAudioPacketizerConfig{ .ssrc = id });
+        // starts spread over the interval, as independent streams would be
+        streamStarts.push_back(start + ((s_frameInterval * id) / nStreams));
+        pacer.Schedule(id, streamStarts.back());
+    }
+
+    auto onDue{ [&](uint32_t id, RtpPacer::Clock::time_point) {
+        auto& stream{ streams[id] };
+        auto buffer{ cache.Acquire() };
+        benchmark::DoNotOptimize(stream.WriteOpusFrame(frame, buffer.Data()));
+        cache.Release(std::move(buffer));
+        pacer.Schedule(id, streamStarts[id] + stream.MediaTime());
+    } };
+
+    auto now{ start };
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        for (int tick{ 0 }; tick < s_frameInterval.count(); ++tick)
+        {
+            now += std::chrono::milliseconds{ 1 };
+            benchmark::DoNotOptimize(pacer.Advance(now, onDue));
+        }
+    }
+    SetPacketCounters(state, allocsBefore, nStreams);
+}
+
+} // namespace
+
+BENCHMARK(BM_AudioPacerInterval)->Arg(1000)->Arg(10000);
+
+} // namespace rtp::bench
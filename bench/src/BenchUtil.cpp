@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "BenchUtil.hpp"
+#include "Common/ByteOrder.hpp"
+#include "Rtcp/RtcpPackets.hpp"
+#include "Rtcp/RtcpWriter.hpp"
+
+namespace
+{
+
+std::atomic<uint64_t> s_allocCount{ 0 };
+
+} // namespace
+
+// Counting replacements of the global allocation functions, the array and nothrow forms forward to these.
+// Kept out of line: once inlined into a caller of this file, GCC pairs the new expression with the std::free below
+// and reports -Wmismatched-new-delete at -O2/-Os.
+[[gnu::noinline]] void* operator new(size_t size)
+{
+    s_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr{ std::malloc(size == 0 ? 1 : size) })
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t /*size*/) noexcept { std::free(ptr); }
+
+// the aligned forms do not go through the plain ones, e.g. PacketBufferPool storage
+[[gnu::noinline]] void* operator new(size_t size, std::align_val_t align)
+{
+    s_allocCount.fetch_add(1, std::memory_order_relaxed);
+    // aligned_alloc wants a non-zero multiple of the alignment
+    auto alignment{ static_cast<size_t>(align) };
+    size_t rounded{ size == 0 ? alignment : (size + alignment - 1) & ~(alignment - 1) };
+    if (void* ptr{ std::aligned_alloc(alignment, rounded) })
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::align_val_t /*align*/) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t /*size*/, std::align_val_t /*align*/) noexcept
+{
+    std::free(ptr);
+}
+
+namespace rtp::bench
+{
+
+uint64_t AllocCount() { return s_allocCount.load(std::memory_order_relaxed); }
+
+void SetPacketCounters(benchmark::State& state, uint64_t allocsBefore, uint64_t nPktsPerIter)
+{
+    auto nPkts{ static_cast<double>(state.iterations() * nPktsPerIter) };
+    state.counters["pkts/s"] = benchmark::Counter(nPkts, benchmark::Counter::kIsRate);
+    state.counters["ns/pkt"] = benchmark::Counter(
+        nPkts, benchmark::Counter::kIsRate | benchmark::Counter::kInvert, benchmark::Counter::kIs1000
+    );
+    state.counters["allocs/pkt"] = static_cast<double>(AllocCount() - allocsBefore) / nPkts;
+}
+
+std::vector<uint8_t> MakeSrSdesPacket()
+{
+    std::vector<uint8_t> buf(1500);
+    RtcpWriter writer{ buf };
+
+    RtcpSenderReportPkt sr{};
+    sr.header.ssrc = 0x11223344;
+    sr.header.ntpTimestampMsb = 0xE8000000;
+    sr.header.ntpTimestampLsb = 0x12345678;
+    sr.header.rtpTimestamp = 90000;
+    sr.header.senderPktCnt = 1000;
+    sr.header.senderOctetCnt = 1'000'000;
+    sr.rrBlocks.push_back(RtcpReportBlock{
+        .ssrc = 0x55667788,
+        .fractionLost = 0,
+        .cumNumPktsLost = 0,
+        .extHighestSeqNumRx = 4000,
+        .intervalJitter = 12,
+        .lastSr = 0,
+        .delayLastSr = 0,
+    });
+    writer.WriteSenderReport(sr);
+
+    RtcpSdesPkt sdes{};
+    sdes.chunks.push_back(
+        RtcpSdesChunk{ .ssrc = 0x11223344, .sdeItems = { RtcpSdesVariantCname{ "user@host.example.com" } } }
+    );
+    writer.WriteSdes(sdes);
+
+    buf.resize(writer.Size());
+    return buf;
+}
+
+std::vector<uint8_t> MakeRr31Packet()
+{
+    std::vector<uint8_t> buf(1500);
+    RtcpWriter writer{ buf };
+
+    RtcpReceiverReportPkt rr{};
+    rr.header.ssrc = 0x11223344;
+    for (uint32_t i{ 0 }; i < 31; ++i)
+    {
+        rr.rrBlocks.push_back(RtcpReportBlock{
+            .ssrc = 0x1000 + i,
+            .fractionLost = static_cast<uint8_t>(i),
+            .cumNumPktsLost = i * 3,
+            .extHighestSeqNumRx = 70000 + i,
+            .intervalJitter = i,
+            .lastSr = 0xABCD0000 + i,
+            .delayLastSr = 0x8000,
+        });
+    }
+    writer.WriteReceiverReport(rr);
+
+    buf.resize(writer.Size());
+    return buf;
+}
+
+std::vector<uint8_t> MakeAppPacket(size_t appDataSize)
+{
+    std::vector<uint8_t> buf(appDataSize + 64);
+    RtcpWriter writer{ buf };
+
+    RtcpAppPkt app{};
+    app.header.ssrc = 0x11223344;
+    app.header.name = { 'b', 'e', 'n', 'c' };
+    app.data.assign(appDataSize, 0xA5);
+    writer.WriteApp(app);
+
+    buf.resize(writer.Size());
+    return buf;
+}
+
+std::vector<uint8_t> MakeBadVersionPacket()
+{
+    auto buf{ MakeSrSdesPacket() };
+    // V=1
+    buf[0] = static_cast<uint8_t>((buf[0] & 0x3F) | 0x40);
+    return buf;
+}
+
+std::vector<uint8_t> MakeLengthOverrunPacket()
+{
+    auto buf{ MakeSrSdesPacket() };
+    buf.resize(buf.size() - 4);
+    return buf;
+}
+
+std::vector<uint8_t> MakeRtpPacket(size_t payloadSize)
+{
+    constexpr std::array<uint8_t, 28> header{
+        // V=2 X=1 CC=1, M=1 PT=96, seq
+        0x91, 0xE0, 0x12, 0x34,
+        // timestamp
+        0x00, 0x01, 0x5F, 0x90,
+        // SSRC
+        0x11, 0x22, 0x33, 0x44,
+        // CSRC
+        0x55, 0x66, 0x77, 0x88,
+        // one-byte extension block, 2 words
+        0xBE, 0xDE, 0x00, 0x02,
+        // id 1 with 3 bytes (abs-send-time like), id 2 with 2 bytes, padding
+        0x12, 0xAA, 0xBB, 0xCC, 0x21, 0x01, 0x02, 0x00,
+    };
+
+    // sized up front, growing an initializer-list vector trips a GCC 12 -Warray-bounds false positive at -O2
+    std::vector<uint8_t> buf(header.size() + payloadSize, 0x5A);
+    std::copy(header.begin(), header.end(), buf.begin());
+    return buf;
+}
+
+} // namespace rtp::bench
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+
+namespace rtp::bench
+{
+
+// Number of global operator new calls so far in this process
+uint64_t AllocCount();
+
+// Reports packets/sec and allocations/packet, with one packet processed per iteration and nPktsPerIter packets per
+// iteration otherwise. allocsBefore is AllocCount() taken right before the timing loop.
+void SetPacketCounters(benchmark::State& state, uint64_t allocsBefore, uint64_t nPktsPerIter = 1);
+
+// Compound SR (one report block) + SDES with a CNAME, the usual sender RTCP interval packet
+std::vector<uint8_t> MakeSrSdesPacket();
+
+// RR carrying the maximum 31 report blocks
+std::vector<uint8_t> MakeRr31Packet();
+
+// APP with a payload of appDataSize bytes
+std::vector<uint8_t> MakeAppPacket(size_t appDataSize);
+
+// Version 1 common header
+std::vector<uint8_t> MakeBadVersionPacket();
+
+// Valid SR followed by a sub-packet whose length runs past the buffer
+std::vector<uint8_t> MakeLengthOverrunPacket();
+
+// RTP packet with a CSRC, a one-byte header extension block and payloadSize bytes of payload
+std::vector<uint8_t> MakeRtpPacket(size_t payloadSize);
+
+} // namespace rtp::bench
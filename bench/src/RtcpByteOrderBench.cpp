@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "BenchUtil.hpp"
+#include "Rtcp/RtcpByteOrder.hpp"
+#include "Rtcp/RtcpReceiverRr.hpp"
+#include "Rtcp/RtcpSenderRr.hpp"
+
+namespace rtp::bench
+{
+
+namespace
+{
+
+std::span<const RtcpReportBlock> Rr31Blocks(const std::vector<uint8_t>& pkt)
+{
+    return { reinterpret_cast<const RtcpReportBlock*>(pkt.data() + sizeof(RtcpReceiverReportHeader)), 31 };
+}
+
+void BM_DecodeReportBlocksAoS(benchmark::State& state, RtcpSimdLevel level)
+{
+    ForceSimdLevel(level);
+    if (ActiveSimdLevel() != level)
+    {
+        state.SkipWithError("SIMD level not supported by this CPU");
+        return;
+    }
+
+    auto pkt{ MakeRr31Packet() };
+    std::array<RtcpReportBlock, 31> host{};
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        DecodeReportBlocks(Rr31Blocks(pkt), host);
+        benchmark::DoNotOptimize(host);
+    }
+    SetPacketCounters(state, allocsBefore);
+    ForceSimdLevel(DetectedSimdLevel());
+}
+
+void BM_DecodeReportBlocksSoA(benchmark::State& state, RtcpSimdLevel level)
+{
+    ForceSimdLevel(level);
+    if (ActiveSimdLevel() != level)
+    {
+        state.SkipWithError("SIMD level not supported by this CPU");
+        return;
+    }
+
+    auto pkt{ MakeRr31Packet() };
+    RtcpReportBlocksSoA host{};
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        DecodeReportBlocks(Rr31Blocks(pkt), host);
+        benchmark::DoNotOptimize(host);
+    }
+    SetPacketCounters(state, allocsBefore);
+    ForceSimdLevel(DetectedSimdLevel());
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_DecodeReportBlocksAoS, Scalar, RtcpSimdLevel::Scalar);
+BENCHMARK_CAPTURE(BM_DecodeReportBlocksAoS, Ssse3, RtcpSimdLevel::Ssse3);
+BENCHMARK_CAPTURE(BM_DecodeReportBlocksAoS, Avx2, RtcpSimdLevel::Avx2);
+BENCHMARK_CAPTURE(BM_DecodeReportBlocksSoA, Scalar, RtcpSimdLevel::Scalar);
+BENCHMARK_CAPTURE(BM_DecodeReportBlocksSoA, Ssse3, RtcpSimdLevel::Ssse3);
+BENCHMARK_CAPTURE(BM_DecodeReportBlocksSoA, Avx2, RtcpSimdLevel::Avx2);
+
+} // namespace rtp::bench
@@ -0,0 +1,171 @@
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "BenchUtil.hpp"
+#include "Rtcp/RtcpBatch.hpp"
+#include "Rtcp/RtcpCnameTable.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpMetrics.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtcp/RtcpParser.hpp"
+
+namespace rtp::bench
+{
+
+namespace
+{
+
+using PacketFactory = std::vector<uint8_t> (*)();
+
+std::vector<uint8_t> MakeLargeAppPacket() { return MakeAppPacket(1200); }
+
+void BM_ParseRtcp(benchmark::State& state, PacketFactory makePacket)
+{
+    auto pkt{ makePacket() };
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        auto res{ ParseRtcp(pkt) };
+        benchmark::DoNotOptimize(res);
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+void BM_ParseRtcpView(benchmark::State& state, PacketFactory makePacket)
+{
+    auto pkt{ makePacket() };
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        if (auto compound{ ParseRtcpView(pkt) })
+        {
+            for (const auto& view : *compound)
+            {
+                benchmark::DoNotOptimize(view);
+            }
+        }
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+void BM_ParseRtcpVisitor(benchmark::State& state, PacketFactory makePacket)
+{
+    auto pkt{ makePacket() };
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        bool ok{ ParseRtcp(std::span<const uint8_t>{ pkt }, [](const auto& view) { benchmark::DoNotOptimize(view); }) };
+        benchmark::DoNotOptimize(ok);
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+// only the SR sender info is wanted, every other sub-packet is stepped over
+void BM_ParseRtcpVisitorSrOnly(benchmark::State& state, PacketFactory makePacket)
+{
+    auto pkt{ makePacket() };
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        uint32_t ntpMsb{ 0 };
+        ParseRtcp(
+            std::span<const uint8_t>{ pkt },
+            [&](const RtcpSenderReportView& sr)
+            {
+                ntpMsb = sr.header->ntpTimestampMsb;
+                return RtcpVisit::Stop;
+            }
+        );
+        benchmark::DoNotOptimize(ntpMsb);
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+// SDES CNAMEs resolved to interned IDs straight from the packet, as a receiver does every RTCP interval
+void BM_SdesCnameIntern(benchmark::State& state, PacketFactory makePacket)
+{
+    auto pkt{ makePacket() };
+    RtcpCnameTable cnames{};
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        ParseRtcp(
+            std::span<const uint8_t>{ pkt },
+            [&](const RtcpSdesView& sdes)
+            {
+                for (const auto& chunk : sdes.Chunks())
+                {
+                    if (auto cname{ chunk.Cname() })
+                    {
+                        benchmark::DoNotOptimize(cnames.Intern(*cname));
+                    }
+                }
+            }
+        );
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+void BM_ParseRtcpBatch(benchmark::State& state, PacketFactory makePacket)
+{
+    constexpr size_t batchSize{ 64 };
+    std::vector<std::vector<uint8_t>> pkts(batchSize, makePacket());
+    std::vector<std::span<const uint8_t>> batch(pkts.begin(), pkts.end());
+
+    RtcpBatchResult result{};
+    result.Reserve(batchSize, batchSize * 4);
+
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        auto nOk{ ParseRtcpBatch(batch, result) };
+        benchmark::DoNotOptimize(nOk);
+    }
+    SetPacketCounters(state, allocsBefore, batchSize);
+}
+
+// Metrics bookkeeping of one compound with state.range(0) sub-packets, without any parsing. Run it, and the parser
+// benchmarks, from a build with -DRTP_PACKETIZER_METRICS=OFF too to see what the metrics cost.
+void BM_RtcpParseScope(benchmark::State& state)
+{
+    constexpr std::array<uint8_t, 4> pktTypes{
+        RtcpType::SenderRR, RtcpType::Sdes, RtcpType::RtpFeedback, RtcpType::PayloadFeedback
+    };
+    auto nPkts{ static_cast<size_t>(state.range(0)) };
+    state.SetLabel(RTP_PACKETIZER_METRICS ? "metrics on" : "metrics off");
+
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        RtcpParseScope scope{};
+        scope.Leading(pktTypes[0]);
+        for (size_t i{ 0 }; i < nPkts; ++i)
+        {
+            scope.Parsed(pktTypes[i % pktTypes.size()]);
+        }
+        benchmark::ClobberMemory();
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+} // namespace
+
+#define RTCP_BENCH_INPUTS(func)                                                                                        \
+    BENCHMARK_CAPTURE(func, SrSdes, MakeSrSdesPacket);                                                                 \
+    BENCHMARK_CAPTURE(func, Rr31Blocks, MakeRr31Packet);                                                               \
+    BENCHMARK_CAPTURE(func, App1200, MakeLargeAppPacket);                                                              \
+    BENCHMARK_CAPTURE(func, BadVersion, MakeBadVersionPacket);                                                         \
+    BENCHMARK_CAPTURE(func, LengthOverrun, MakeLengthOverrunPacket)
+
+RTCP_BENCH_INPUTS(BM_ParseRtcp);
+RTCP_BENCH_INPUTS(BM_ParseRtcpView);
+RTCP_BENCH_INPUTS(BM_ParseRtcpVisitor);
+RTCP_BENCH_INPUTS(BM_ParseRtcpBatch);
+BENCHMARK_CAPTURE(BM_ParseRtcpVisitorSrOnly, SrSdes, MakeSrSdesPacket);
+BENCHMARK_CAPTURE(BM_SdesCnameIntern, SrSdes, MakeSrSdesPacket);
+BENCHMARK(BM_RtcpParseScope)->Arg(1)->Arg(2)->Arg(4);
+
+} // namespace rtp::bench
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <endian.h>
+#include <vector>
+#include "BenchUtil.hpp"
+#include "Rtp/RtpForwarder.hpp"
+#include "Rtp/RtpHeader.hpp"
+#include "Rtp/RtpPacketizer.hpp"
+
+namespace rtp::bench
+{
+
+namespace
+{
+
+constexpr size_t s_payloadSize{ 1200 };
+
+std::vector<RtpForwardLeg> MakeLegs(size_t nLegs)
+{
+    std::vector<RtpForwardLeg> legs{};
+    for (size_t i{ 0 }; i < nLegs; ++i)
+    {
+        legs.push_back(RtpForwardLeg{
+            .ssrc = static_cast<uint32_t>(0x1000 + i),
+            .seqOffset = static_cast<uint16_t>(i * 7),
+            .tsOffset = static_cast<uint32_t>(i * 90000),
+        });
+    }
+    return legs;
+}
+
+// state.range(0) is the number of legs, packets are counted per leg
+void BM_RtpForward(benchmark::State& state)
+{
+    auto nLegs{ static_cast<size_t>(state.range(0)) };
+    auto pkt{ MakeRtpPacket(s_payloadSize) };
+    auto legs{ MakeLegs(nLegs) };
+    std::vector<RtpOutPacket> out(nLegs);
+    RtpForwarder forwarder{};
+
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(forwarder.Forward(pkt, legs, out));
+        benchmark::ClobberMemory();
+    }
+    SetPacketCounters(state, allocsBefore, nLegs);
+}
+
+// Baseline: the whole packet copied into a buffer per leg, then the header rewritten
+void BM_RtpForwardCopy(benchmark::State& state)
+{
+    auto nLegs{ static_cast<size_t>(state.range(0)) };
+    auto pkt{ MakeRtpPacket(s_payloadSize) };
+    auto legs{ MakeLegs(nLegs) };
+    std::vector<std::vector<uint8_t>> copies(nLegs, std::vector<uint8_t>(pkt.size()));
+
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        for (size_t i{ 0 }; i < nLegs; ++i)
+        {
+            auto* copy{ copies[i].data() };
+            std::memcpy(copy, pkt.data(), pkt.size());
+            auto* header{ reinterpret_cast<RptHeader*>(copy) };
+            header->seq = htobe16(static_cast<uint16_t>(be16toh(header->seq) + legs[i].seqOffset));
+            header->ts = htobe32(be32toh(header->ts) + legs[i].tsOffset);
+            header->ssrc = htobe32(legs[i].ssrc);
+        }
+        benchmark::ClobberMemory();
+    }
+    SetPacketCounters(state, allocsBefore, nLegs);
+}
+
+} // namespace
+
+BENCHMARK(BM_RtpForward)->Arg(10)->Arg(100);
+BENCHMARK(BM_RtpForwardCopy)->Arg(10)->Arg(100);
+
+} // namespace rtp::bench
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "BenchUtil.hpp"
+#include "Rtp/RtpParser.hpp"
+
+namespace rtp::bench
+{
+
+namespace
+{
+
+void BM_ParseRtp(benchmark::State& state)
+{
+    auto pkt{ MakeRtpPacket(static_cast<size_t>(state.range(0))) };
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        auto view{ ParseRtp(pkt) };
+        benchmark::DoNotOptimize(view);
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+void BM_ParseRtpWithExtensions(benchmark::State& state)
+{
+    auto pkt{ MakeRtpPacket(static_cast<size_t>(state.range(0))) };
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        if (auto view{ ParseRtp(pkt) })
+        {
+            for (const auto& element : view->Extensions())
+            {
+                benchmark::DoNotOptimize(element);
+            }
+        }
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+} // namespace
+
+BENCHMARK(BM_ParseRtp)->Arg(160)->Arg(1200);
+BENCHMARK(BM_ParseRtpWithExtensions)->Arg(160)->Arg(1200);
+
+} // namespace rtp::bench
@@ -0,0 +1,95 @@
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BenchUtil.hpp"
+#include "Srtp/SrtpSession.hpp"
+
+namespace rtp::bench
+{
+
+namespace
+{
+
+constexpr size_t s_batchSize{ 32 };
+
+constexpr std::array<uint8_t, s_srtpMasterKeySize> s_masterKey{
+    0xE1, 0xF9, 0x7A, 0x0D, 0x3E, 0x01, 0x8B, 0xE0, 0xD6, 0x4F, 0xA3, 0x2C, 0x06, 0xDE, 0x41, 0x39,
+};
+
+constexpr std::array<uint8_t, 14> s_masterSalt{
+    0x0E, 0xC6, 0x75, 0xAD, 0x49, 0x8A, 0xFE, 0xEB, 0xB6, 0x96, 0x0B, 0x3A, 0xAB, 0xE6,
+};
+
+SrtpSession MakeSession(SrtpProfile profile)
+{
+    return *SrtpSession::Create(profile, s_masterKey, std::span{ s_masterSalt }.first(SrtpMasterSaltSize(profile)));
+}
+
+// state.range(0) is the payload size, state.range(1) the profile
+void BM_SrtpProtectRtp(benchmark::State& state)
+{
+    auto profile{ static_cast<SrtpProfile>(state.range(1)) };
+    auto session{ MakeSession(profile) };
+    auto pkt{ MakeRtpPacket(static_cast<size_t>(state.range(0))) };
+    size_t pktSize{ pkt.size() };
+    pkt.resize(pktSize + SrtpRtpOverhead(profile));
+
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        // re-encrypting the previous ciphertext costs the same
+        size_t size{ pktSize };
+        benchmark::DoNotOptimize(session.ProtectRtp(pkt, size));
+    }
+    SetPacketCounters(state, allocsBefore);
+}
+
+void BM_SrtpProtectRtpBatch(benchmark::State& state)
+{
+    auto profile{ static_cast<SrtpProfile>(state.range(1)) };
+    auto session{ MakeSession(profile) };
+    auto templatePkt{ MakeRtpPacket(static_cast<size_t>(state.range(0))) };
+    size_t pktSize{ templatePkt.size() };
+    templatePkt.resize(pktSize + SrtpRtpOverhead(profile));
+
+    std::vector<std::vector<uint8_t>> bufs(s_batchSize, templatePkt);
+    std::vector<SrtpPacket> pkts{};
+    for (auto& buf : bufs)
+    {
+        pkts.push_back(SrtpPacket{ buf, pktSize });
+    }
+
+    // first call sizes the session's scratch
+    session.ProtectRtp(pkts);
+
+    auto allocsBefore{ AllocCount() };
+    for (auto _ : state)
+    {
+        for (auto& pkt : pkts)
+        {
+            pkt.size = pktSize;
+        }
+        benchmark::DoNotOptimize(session.ProtectRtp(pkts));
+    }
+    SetPacketCounters(state, allocsBefore, s_batchSize);
+}
+
+void ProfileArgs(benchmark::internal::Benchmark* bench)
+{
+    for (auto profile : { SrtpProfile::Aes128CmHmacSha1_80, SrtpProfile::AeadAes128Gcm })
+    {
+        for (int64_t payload : { 160, 1200 })
+        {
+            bench->Args({ payload, static_cast<int64_t>(profile) });
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_SrtpProtectRtp)->Apply(ProfileArgs);
+BENCHMARK(BM_SrtpProtectRtpBatch)->Apply(ProfileArgs);
+
+} // namespace rtp::bench
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <endian.h>
+
+namespace rtp
+{
+
+// Unaligned network byte order loads and stores for building and reading packets in place
+
+inline uint16_t LoadBe16(const uint8_t* src)
+{
+    uint16_t val{};
+    std::memcpy(&val, src, sizeof(val));
+    return be16toh(val);
+}
+
+inline uint32_t LoadBe24(const uint8_t* src)
+{
+    return (static_cast<uint32_t>(src[0]) << 16) | (static_cast<uint32_t>(src[1]) << 8) | src[2];
+}
+
+inline uint32_t LoadBe32(const uint8_t* src)
+{
+    uint32_t val{};
+    std::memcpy(&val, src, sizeof(val));
+    return be32toh(val);
+}
+
+inline void StoreBe16(uint8_t* dst, uint16_t val)
+{
+    val = htobe16(val);
+    std::memcpy(dst, &val, sizeof(val));
+}
+
+inline void StoreBe24(uint8_t* dst, uint32_t val)
+{
+    dst[0] = static_cast<uint8_t>(val >> 16);
+    dst[1] = static_cast<uint8_t>(val >> 8);
+    dst[2] = static_cast<uint8_t>(val);
+}
+
+inline void StoreBe32(uint8_t* dst, uint32_t val)
+{
+    val = htobe32(val);
+    std::memcpy(dst, &val, sizeof(val));
+}
+
+} // namespace rtp
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <utility>
+#include <variant>
+
+namespace rtp
+{
+
+// Wraps an error so Expected can tell it apart from a value, like std::unexpected
+template<typename E>
+struct Unexpected
+{
+    E error;
+};
+
+template<typename E>
+Unexpected(E) -> Unexpected<E>;
+
+/**
+Either a value or the error that prevented producing it, a C++20 stand-in for std::expected.
+
+Accessing the side that is not held is undefined, check HasValue (or the bool conversion) first.
+*/
+
+template<typename T, typename E>
+class Expected
+{
+public:
+    Expected(T value) :
+        m_storage{ std::in_place_index<0>, std::move(value) }
+    {
+    }
+
+    Expected(Unexpected<E> error) :
+        m_storage{ std::in_place_index<1>, std::move(error.error) }
+    {
+    }
+
+    bool HasValue() const { return m_storage.index() == 0; }
+
+    explicit operator bool() const { return HasValue(); }
+
+    T& Value() { return *std::get_if<0>(&m_storage); }
+
+    const T& Value() const { return *std::get_if<0>(&m_storage); }
+
+    const E& Error() const { return *std::get_if<1>(&m_storage); }
+
+    T& operator*() { return Value(); }
+
+    const T& operator*() const { return Value(); }
+
+    T* operator->() { return &Value(); }
+
+    const T* operator->() const { return &Value(); }
+
+private:
+    std::variant<T, E> m_storage;
+};
+
+} // namespace rtp
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Common/PacketBufferPool.hpp"
+
+namespace rtp
+{
+
+namespace
+{
+
+constexpr size_t s_cacheLine{ 64 };
+
+constexpr uint64_t MakeHead(uint64_t prevHead, uint32_t index) { return (((prevHead >> 32) + 1) << 32) | index; }
+
+} // namespace
+
+PacketBuffer& PacketBuffer::operator=(PacketBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        m_pool = std::exchange(other.m_pool, nullptr);
+        m_index = other.m_index;
+        m_size = other.m_size;
+    }
+    return *this;
+}
+
+void PacketBuffer::Reset()
+{
+    if (m_pool != nullptr)
+    {
+        std::exchange(m_pool, nullptr)->Push(m_index);
+    }
+    m_size = 0;
+}
+
+std::span<uint8_t> PacketBuffer::Data() const
+{
+    return m_pool != nullptr ? std::span<uint8_t>{ m_pool->BufferData(m_index), m_pool->BufferSize() }
+                             : std::span<uint8_t>{};
+}
+
+void PacketBuffer::SetSize(size_t size) { m_size = static_cast<uint32_t>(std::min(size, Data().size())); }
+
+PacketBufferPool::PacketBufferPool(size_t count, size_t bufferSize) :
+    m_count{ std::min<size_t>(count, PacketBufferPool::s_nil) },
+    m_bufferSize{ bufferSize },
+    // with the storage cache line aligned, buffers never share a cache line
+    m_stride{ (bufferSize + s_cacheLine - 1) & ~(s_cacheLine - 1) },
+    m_head{ MakeHead(0, m_count > 0 ? 0 : s_nil) }
+{
+    m_storage.reset(static_cast<uint8_t*>(::operator new[](m_count * m_stride, std::align_val_t{ s_cacheLine })));
+    m_next = std::make_unique<std::atomic<uint32_t>[]>(m_count);
+    for (size_t i{ 0 }; i < m_count; ++i)
+    {
+        m_next[i].store(i + 1 < m_count ? static_cast<uint32_t>(i + 1) : s_nil, std::memory_order_relaxed);
+    }
+}
+
+void PacketBufferPool::AlignedFree::operator()(uint8_t* storage) const
+{
+    ::operator delete[](storage, std::align_val_t{ s_cacheLine });
+}
+
+PacketBuffer PacketBufferPool::Acquire()
+{
+    uint32_t index{ Pop() };
+    return index != s_nil ? PacketBuffer{ this, index } : PacketBuffer{};
+}
+
+uint32_t PacketBufferPool::Pop()
+{
+    uint64_t head{ m_head.load(std::memory_order_acquire) };
+    while (true)
+    {
+        auto index{ static_cast<uint32_t>(head) };
+        if (index == s_nil)
+        {
+            return s_nil;
+        }
+
+        // may read a stale next if another thread popped index meanwhile, the tag then fails the exchange
+        uint32_t next{ m_next[index].load(std::memory_order_relaxed) };
+        if (m_head.compare_exchange_weak(head, MakeHead(head, next), std::memory_order_acquire))
+        {
+            return index;
+        }
+    }
+}
+
+size_t PacketBufferPool::PopChain(size_t n, std::vector<uint32_t>& out)
+{
+    size_t outSize{ out.size() };
+    uint64_t head{ m_head.load(std::memory_order_acquire) };
+    while (n > 0 && static_cast<uint32_t>(head) != s_nil)
+    {
+        // walk n links from the top, any pop or push meanwhile bumps the tag and the exchange fails, as in Pop
+        auto next{ static_cast<uint32_t>(head) };
+        while (out.size() - outSize < n && next != s_nil)
+        {
+            out.push_back(next);
+            next = m_next[next].load(std::memory_order_relaxed);
+        }
+
+        if (m_head.compare_exchange_weak(head, MakeHead(head, next), std::memory_order_acquire))
+        {
+            break;
+        }
+        out.resize(outSize);
+    }
+
+    return out.size() - outSize;
+}
+
+void PacketBufferPool::PushChain(uint32_t first, uint32_t last)
+{
+    uint64_t head{ m_head.load(std::memory_order_relaxed) };
+    do
+    {
+        m_next[last].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(
+        head, MakeHead(head, first), std::memory_order_release, std::memory_order_relaxed
+    ));
+}
+
+PacketBufferCache::PacketBufferCache(PacketBufferPool& pool, size_t capacity) :
+    m_pool{ pool },
+    m_capacity{ std::max<size_t>(capacity, 2) }
+{
+    m_local.reserve(m_capacity);
+}
+
+PacketBufferCache::~PacketBufferCache() { Flush(m_local.size()); }
+
+PacketBuffer PacketBufferCache::Acquire()
+{
+    if (m_local.empty() && m_pool.PopChain(m_capacity / 2, m_local) == 0)
+    {
+        return {};
+    }
+
+    uint32_t index{ m_local.back() };
+    m_local.pop_back();
+    return PacketBuffer{ &m_pool, index };
+}
+
+void PacketBufferCache::Release(PacketBuffer&& buffer)
+{
+    if (buffer.m_pool != &m_pool)
+    {
+        buffer.Reset();
+        return;
+    }
+
+    if (m_local.size() == m_capacity)
+    {
+        Flush(m_capacity / 2);
+    }
+    m_local.push_back(buffer.Detach());
+}
+
+void PacketBufferCache::Flush(size_t n)
+{
+    if (n == 0)
+    {
+        return;
+    }
+
+    // link the batch locally, then publish it with a single exchange
+    auto batch{ std::span{ m_local }.last(n) };
+    for (size_t i{ 0 }; i + 1 < batch.size(); ++i)
+    {
+        m_pool.m_next[batch[i]].store(batch[i + 1], std::memory_order_relaxed);
+    }
+    m_pool.PushChain(batch.front(), batch.back());
+    m_local.resize(m_local.size() - n);
+}
+
+} // namespace rtp
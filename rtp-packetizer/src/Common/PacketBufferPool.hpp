@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace rtp
+{
+
+class PacketBufferPool;
+
+/**
+Move-only handle to one buffer of a PacketBufferPool.
+
+Dropping a handle returns the buffer to its pool's shared free list, which is lock-free, so a buffer may be released on
+any thread, not just the one that acquired it. Handles must not outlive their pool.
+*/
+
+class PacketBuffer
+{
+public:
+    PacketBuffer() = default;
+
+    PacketBuffer(const PacketBuffer&) = delete;
+    PacketBuffer& operator=(const PacketBuffer&) = delete;
+
+    PacketBuffer(PacketBuffer&& other) noexcept :
+        m_pool{ std::exchange(other.m_pool, nullptr) },
+        m_index{ other.m_index },
+        m_size{ other.m_size }
+    {
+    }
+
+    PacketBuffer& operator=(PacketBuffer&& other) noexcept;
+
+    ~PacketBuffer() { Reset(); }
+
+    void Reset();
+
+    explicit operator bool() const { return m_pool != nullptr; }
+
+    // The whole buffer, to receive or build a packet into
+    std::span<uint8_t> Data() const;
+
+    // The first Size() bytes of the buffer
+    std::span<uint8_t> Bytes() const { return Data().first(m_size); }
+
+    size_t Size() const { return m_size; }
+
+    // Clamped to the buffer size
+    void SetSize(size_t size);
+
+private:
+    friend class PacketBufferPool;
+    friend class PacketBufferCache;
+
+    PacketBuffer(PacketBufferPool* pool, uint32_t index) : m_pool{ pool }, m_index{ index } {}
+
+    // Hands the buffer index over to the caller, leaving the handle empty
+    uint32_t Detach()
+    {
+        m_pool = nullptr;
+        return m_index;
+    }
+
+    PacketBufferPool* m_pool{ nullptr };
+    uint32_t m_index{ 0 };
+    uint32_t m_size{ 0 };
+};
+
+/**
+Fixed set of equally sized packet buffers, allocated once at construction.
+
+Free buffers form a lock-free stack (an index list with an ABA tag in the head word), shared by every thread. Workers
+that acquire and release buffers at a high rate should go through a PacketBufferCache, so that most operations stay
+thread-local and only batches touch the shared stack.
+*/
+
+class PacketBufferPool
+{
+public:
+    PacketBufferPool(size_t count, size_t bufferSize = 2048);
+
+    PacketBufferPool(const PacketBufferPool&) = delete;
+    PacketBufferPool& operator=(const PacketBufferPool&) = delete;
+    PacketBufferPool(PacketBufferPool&&) = delete;
+    PacketBufferPool& operator=(PacketBufferPool&&) = delete;
+
+    // Empty handle if every buffer is in use or sitting in a cache. Any thread.
+    PacketBuffer Acquire();
+
+    size_t BufferSize() const { return m_bufferSize; }
+
+    size_t Count() const { return m_count; }
+
+private:
+    friend class PacketBuffer;
+    friend class PacketBufferCache;
+
+    static constexpr uint32_t s_nil{ UINT32_MAX };
+
+    uint32_t Pop();
+
+    // Pops up to n buffers with a single exchange of the head, appending their indices to out. Returns how many.
+    size_t PopChain(size_t n, std::vector<uint32_t>& out);
+
+    void Push(uint32_t index) { PushChain(index, index); }
+
+    // Pushes a chain first..last already linked through m_next
+    void PushChain(uint32_t first, uint32_t last);
+
+    uint8_t* BufferData(uint32_t index) const { return m_storage.get() + (index * m_stride); }
+
+    // Storage comes from the cache line aligned operator new[], it must go back through the matching delete
+    struct AlignedFree
+    {
+        void operator()(uint8_t* storage) const;
+    };
+
+    std::unique_ptr<uint8_t[], AlignedFree> m_storage;
+    std::unique_ptr<std::atomic<uint32_t>[]> m_next;
+    size_t m_count;
+    size_t m_bufferSize;
+    size_t m_stride;
+    // low 32 bits index of the top buffer, high 32 bits bumped on every update against ABA
+    alignas(64) std::atomic<uint64_t> m_head;
+};
+
+/**
+Per-thread front end of a PacketBufferPool.
+
+Keeps up to capacity free buffers local to the owning thread. Acquire refills half the capacity from the pool when
+empty, Release flushes half back when full, each as one batch in a single exchange on the shared stack. A cache belongs
+to a single thread. Buffers released without going through a cache, e.g. on another worker, simply go back to the pool.
+*/
+
+class PacketBufferCache
+{
+public:
+    explicit PacketBufferCache(PacketBufferPool& pool, size_t capacity = 64);
+
+    PacketBufferCache(const PacketBufferCache&) = delete;
+    PacketBufferCache& operator=(const PacketBufferCache&) = delete;
+
+    // Returns the cached buffers to the pool
+    ~PacketBufferCache();
+
+    PacketBuffer Acquire();
+
+    // Buffers of another pool are passed on to their own pool
+    void Release(PacketBuffer&& buffer);
+
+    size_t Cached() const { return m_local.size(); }
+
+private:
+    // Returns the last n cached buffers to the pool in one push
+    void Flush(size_t n);
+
+    PacketBufferPool& m_pool;
+    std::vector<uint32_t> m_local;
+    size_t m_capacity;
+};
+
+} // namespace rtp
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace rtp
+{
+
+/**
+Bounded single-producer single-consumer ring.
+
+Exactly one thread may push and exactly one (other) thread may pop. The capacity is rounded up to a power of two and
+all slots are allocated at construction. Producer and consumer indices live on separate cache lines, each side also
+caches the other's index so the shared line is only re-read when the ring looks full or empty.
+*/
+
+template<typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity) :
+        m_mask{ std::bit_ceil(std::max<size_t>(capacity, 2)) - 1 },
+        m_slots{ std::make_unique<T[]>(m_mask + 1) }
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side. Leaves item untouched and returns false when full.
+    bool TryPush(T& item)
+    {
+        size_t tail{ m_tail.load(std::memory_order_relaxed) };
+        if (tail - m_cachedHead > m_mask)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask)
+            {
+                return false;
+            }
+        }
+
+        m_slots[tail & m_mask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    std::optional<T> TryPop()
+    {
+        size_t head{ m_head.load(std::memory_order_relaxed) };
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+            {
+                return std::nullopt;
+            }
+        }
+
+        std::optional<T> item{ std::move(m_slots[head & m_mask]) };
+        m_head.store(head + 1, std::memory_order_release);
+        return item;
+    }
+
+    size_t Capacity() const { return m_mask + 1; }
+
+    // Approximate when called while the other side is running
+    size_t Size() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t s_cacheLine{ 64 };
+
+    const size_t m_mask;
+    std::unique_ptr<T[]> m_slots;
+
+    // consumer owned
+    alignas(s_cacheLine) std::atomic<size_t> m_head{ 0 };
+    size_t m_cachedTail{ 0 };
+
+    // producer owned
+    alignas(s_cacheLine) std::atomic<size_t> m_tail{ 0 };
+    size_t m_cachedHead{ 0 };
+};
+
+} // namespace rtp
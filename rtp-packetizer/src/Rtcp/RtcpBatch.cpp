@@ -0,0 +1,59 @@
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "Rtcp/RtcpBatch.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpMetrics.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtcp/RtcpParser.hpp"
+
+namespace rtp
+{
+
+size_t ParseRtcpBatch(std::span<const std::span<const uint8_t>> pkts, RtcpBatchResult& result)
+{
+    result.Clear();
+    result.entries.reserve(pkts.size());
+
+    size_t nOk{ 0 };
+    for (const auto& fullPacket : pkts)
+    {
+        RtcpParseScope scope{};
+        auto firstView{ static_cast<uint32_t>(result.views.size()) };
+
+        // validate first like the streaming parse, so a rejected datagram counts as a drop and nothing else
+        auto status{ ValidateRtcpCompound(fullPacket) };
+        if (status != RtcpParseStatus::Ok)
+        {
+            scope.Drop(RtcpDropOf(status));
+        }
+        else
+        {
+            size_t offset{ 0 };
+            while (offset < fullPacket.size())
+            {
+                const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(fullPacket.data() + offset) };
+                auto rawPkt{ fullPacket.subspan(offset, RtcpPktSize(*cmnHeader)) };
+                auto view{ ParsePktView(rawPkt) };
+                scope.Viewed(cmnHeader->pktType, view.has_value());
+                if (view)
+                {
+                    result.views.emplace_back(*view);
+                }
+
+                offset += rawPkt.size();
+            }
+            ++nOk;
+        }
+
+        result.entries.push_back(RtcpBatchEntry{
+            .status = status,
+            .firstView = firstView,
+            .nViews = static_cast<uint32_t>(result.views.size()) - firstView,
+        });
+    }
+
+    return nOk;
+}
+
+} // namespace rtp
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtcp/RtcpParser.hpp"
+
+namespace rtp
+{
+
+struct RtcpBatchEntry
+{
+    RtcpParseStatus status;
+    uint32_t firstView;
+    uint32_t nViews;
+};
+
+/**
+Caller-owned result arena for ParseRtcpBatch.
+
+Keep one per receive loop and pass it to every call: clearing keeps the capacity, so after the first few batches
+parsing no longer allocates. Views for all packets of the batch are stored back to back in one array.
+*/
+
+struct RtcpBatchResult
+{
+    std::vector<RtcpBatchEntry> entries;
+    std::vector<RtcpPktView> views;
+
+    void Clear()
+    {
+        entries.clear();
+        views.clear();
+    }
+
+    void Reserve(size_t nPkts, size_t nViews)
+    {
+        entries.reserve(nPkts);
+        views.reserve(nViews);
+    }
+
+    size_t Size() const { return entries.size(); }
+
+    RtcpParseStatus Status(size_t pktIdx) const { return entries[pktIdx].status; }
+
+    std::span<const RtcpPktView> Views(size_t pktIdx) const
+    {
+        const auto& entry{ entries[pktIdx] };
+        return std::span{ views }.subspan(entry.firstView, entry.nViews);
+    }
+};
+
+// Parses every datagram of a recvmmsg-style batch into result, replacing its previous contents.
+// Entry i of result matches pkts[i]. A malformed datagram gets no views and its failure status, the others are
+// unaffected. Returns the number of datagrams that parsed Ok.
+size_t ParseRtcpBatch(std::span<const std::span<const uint8_t>> pkts, RtcpBatchResult& result);
+
+} // namespace rtp
@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <endian.h>
+#include <span>
+#include "Rtcp/RtcpByteOrder.hpp"
+#include "Common/ByteOrder.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpSenderRr.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define RTP_HAVE_X86_SIMD 1
+#else
+    #define RTP_HAVE_X86_SIMD 0
+#endif
+
+namespace rtp
+{
+
+namespace
+{
+
+static_assert(sizeof(RtcpReportBlock) == 24, "report block must match its 6 word wire layout");
+
+RtcpReportBlock DecodeReportBlock(const RtcpReportBlock& wire)
+{
+    const auto* src{ reinterpret_cast<const uint8_t*>(&wire) };
+    return RtcpReportBlock{
+        .ssrc = LoadBe32(src),
+        .fractionLost = src[4],
+        .cumNumPktsLost = LoadBe24(src + 5),
+        .extHighestSeqNumRx = LoadBe32(src + 8),
+        .intervalJitter = LoadBe32(src + 12),
+        .lastSr = LoadBe32(src + 16),
+        .delayLastSr = LoadBe32(src + 20),
+    };
+}
+
+void SetSoA(RtcpReportBlocksSoA& soa, size_t idx, const RtcpReportBlock& host)
+{
+    soa.ssrc[idx] = host.ssrc;
+    soa.fractionLost[idx] = host.fractionLost;
+    soa.cumNumPktsLost[idx] = host.cumNumPktsLost;
+    soa.extHighestSeqNumRx[idx] = host.extHighestSeqNumRx;
+    soa.intervalJitter[idx] = host.intervalJitter;
+    soa.lastSr[idx] = host.lastSr;
+    soa.delayLastSr[idx] = host.delayLastSr;
+}
+
+void DecodeAoSScalar(const RtcpReportBlock* wire, RtcpReportBlock* host, size_t count)
+{
+    for (size_t i{ 0 }; i < count; ++i)
+    {
+        host[i] = DecodeReportBlock(wire[i]);
+    }
+}
+
+void DecodeSoAScalar(const RtcpReportBlock* wire, RtcpReportBlocksSoA& host, size_t count)
+{
+    for (size_t i{ 0 }; i < count; ++i)
+    {
+        SetSoA(host, i, DecodeReportBlock(wire[i]));
+    }
+}
+
+#if RTP_HAVE_X86_SIMD
+
+/**
+Byte shuffles turning wire report blocks into host order AoS blocks.
+
+Every word is byte reversed, except the second word of a block (fraction lost, 24-bit cumulative lost) which keeps the
+fraction byte in front and reverses only the 24-bit count. Two blocks span three 16 byte vectors with that word at
+position 1 of the first and position 3 of the second.
+*/
+
+#define RTP_REV_WORD(k) (4 * (k)) + 3, (4 * (k)) + 2, (4 * (k)) + 1, (4 * (k))
+#define RTP_LOSS_WORD(k) (4 * (k)), (4 * (k)) + 3, (4 * (k)) + 2, (4 * (k)) + 1
+
+// _mm_setr_epi8 takes chars, the indices all fit
+constexpr std::array<char, 16> s_maskA{ RTP_REV_WORD(0), RTP_LOSS_WORD(1), RTP_REV_WORD(2), RTP_REV_WORD(3) };
+constexpr std::array<char, 16> s_maskB{ RTP_REV_WORD(0), RTP_REV_WORD(1), RTP_REV_WORD(2), RTP_LOSS_WORD(3) };
+constexpr std::array<char, 16> s_maskC{ RTP_REV_WORD(0), RTP_REV_WORD(1), RTP_REV_WORD(2), RTP_REV_WORD(3) };
+
+#undef RTP_REV_WORD
+#undef RTP_LOSS_WORD
+
+[[gnu::target("ssse3")]] void DecodeAoSSsse3(const RtcpReportBlock* wire, RtcpReportBlock* host, size_t count)
+{
+    const auto maskA{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_maskA.data())) };
+    const auto maskB{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_maskB.data())) };
+    const auto maskC{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_maskC.data())) };
+
+    size_t i{ 0 };
+    for (; i + 2 <= count; i += 2)
+    {
+        const auto* src{ reinterpret_cast<const __m128i*>(wire + i) };
+        auto* dst{ reinterpret_cast<__m128i*>(host + i) };
+
+        auto v0{ _mm_loadu_si128(src) };
+        auto v1{ _mm_loadu_si128(src + 1) };
+        auto v2{ _mm_loadu_si128(src + 2) };
+        _mm_storeu_si128(dst, _mm_shuffle_epi8(v0, maskA));
+        _mm_storeu_si128(dst + 1, _mm_shuffle_epi8(v1, maskB));
+        _mm_storeu_si128(dst + 2, _mm_shuffle_epi8(v2, maskC));
+    }
+
+    DecodeAoSScalar(wire + i, host + i, count - i);
+}
+
+[[gnu::target("avx2")]] void DecodeAoSAvx2(const RtcpReportBlock* wire, RtcpReportBlock* host, size_t count)
+{
+    const auto maskA{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_maskA.data())) };
+    const auto maskB{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_maskB.data())) };
+    const auto maskC{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_maskC.data())) };
+    // four blocks are three 32 byte vectors, lanes AB, CA, BC
+    const auto maskAB{ _mm256_set_m128i(maskB, maskA) };
+    const auto maskCA{ _mm256_set_m128i(maskA, maskC) };
+    const auto maskBC{ _mm256_set_m128i(maskC, maskB) };
+
+    size_t i{ 0 };
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto* src{ reinterpret_cast<const __m256i*>(wire + i) };
+        auto* dst{ reinterpret_cast<__m256i*>(host + i) };
+
+        auto v0{ _mm256_loadu_si256(src) };
+        auto v1{ _mm256_loadu_si256(src + 1) };
+        auto v2{ _mm256_loadu_si256(src + 2) };
+        _mm256_storeu_si256(dst, _mm256_shuffle_epi8(v0, maskAB));
+        _mm256_storeu_si256(dst + 1, _mm256_shuffle_epi8(v1, maskCA));
+        _mm256_storeu_si256(dst + 2, _mm256_shuffle_epi8(v2, maskBC));
+    }
+
+    // the scalar tail is built without AVX and reached by a tail call, clear the upper halves as in DecodeSoAAvx2
+    _mm256_zeroupper();
+    DecodeAoSScalar(wire + i, host + i, count - i);
+}
+
+/**
+Struct of arrays decoding of four blocks (eight with AVX2, one group of four per 128-bit lane) at a time.
+
+Words 0-3 and words 2-5 of each block are loaded as rows and transposed 4x4, giving the ssrc, loss, highest sequence
+and jitter columns from the first and the LSR and DLSR columns from the second. Columns are then byte reversed.
+*/
+
+constexpr std::array<char, 16> s_revWords{ 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+// first byte of each loss word, the fraction lost, packed into the low 4 bytes
+constexpr std::array<char, 16> s_fractionBytes{ 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+[[gnu::target("ssse3")]] void StoreColumn(
+    std::array<uint32_t, RtcpReportBlocksSoA::s_maxBlocks>& field, size_t idx, __m128i value
+)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&field[idx]), value);
+}
+
+// Decodes blocks [first, count) of wire into the same indices of host
+[[gnu::target("ssse3")]] void DecodeSoASsse3From(
+    const RtcpReportBlock* wire, RtcpReportBlocksSoA& host, size_t first, size_t count
+)
+{
+    const auto revWords{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_revWords.data())) };
+    const auto fractionBytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_fractionBytes.data())) };
+    const auto cumMask{ _mm_set1_epi32(0x00FFFFFF) };
+
+    size_t i{ first };
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto* src{ reinterpret_cast<const uint8_t*>(wire + i) };
+        // std::array would drop the vector type attributes
+        __m128i lo[4];
+        __m128i hi[4];
+        for (size_t k{ 0 }; k < 4; ++k)
+        {
+            lo[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (k * sizeof(RtcpReportBlock))));
+            hi[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (k * sizeof(RtcpReportBlock)) + 8));
+        }
+
+        auto t0{ _mm_unpacklo_epi32(lo[0], lo[1]) };
+        auto t1{ _mm_unpacklo_epi32(lo[2], lo[3]) };
+        auto t2{ _mm_unpackhi_epi32(lo[0], lo[1]) };
+        auto t3{ _mm_unpackhi_epi32(lo[2], lo[3]) };
+        auto loss{ _mm_unpackhi_epi64(t0, t1) };
+        StoreColumn(host.ssrc, i, _mm_shuffle_epi8(_mm_unpacklo_epi64(t0, t1), revWords));
+        StoreColumn(host.cumNumPktsLost, i, _mm_and_si128(_mm_shuffle_epi8(loss, revWords), cumMask));
+        StoreColumn(host.extHighestSeqNumRx, i, _mm_shuffle_epi8(_mm_unpacklo_epi64(t2, t3), revWords));
+        StoreColumn(host.intervalJitter, i, _mm_shuffle_epi8(_mm_unpackhi_epi64(t2, t3), revWords));
+
+        auto fraction{ _mm_cvtsi128_si32(_mm_shuffle_epi8(loss, fractionBytes)) };
+        std::memcpy(&host.fractionLost[i], &fraction, sizeof(fraction));
+
+        // only the upper half of the second transpose is new, LSR and DLSR
+        auto t4{ _mm_unpackhi_epi32(hi[0], hi[1]) };
+        auto t5{ _mm_unpackhi_epi32(hi[2], hi[3]) };
+        StoreColumn(host.lastSr, i, _mm_shuffle_epi8(_mm_unpacklo_epi64(t4, t5), revWords));
+        StoreColumn(host.delayLastSr, i, _mm_shuffle_epi8(_mm_unpackhi_epi64(t4, t5), revWords));
+    }
+
+    for (; i < count; ++i)
+    {
+        SetSoA(host, i, DecodeReportBlock(wire[i]));
+    }
+}
+
+void DecodeSoASsse3(const RtcpReportBlock* wire, RtcpReportBlocksSoA& host, size_t count)
+{
+    DecodeSoASsse3From(wire, host, 0, count);
+}
+
+// 128-bit row of block k in the low lane and of block k + 4 in the high lane
+[[gnu::target("avx2")]] __m256i LoadRowPair(const uint8_t* src, size_t k, size_t offset)
+{
+    auto lo{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (k * sizeof(RtcpReportBlock)) + offset)) };
+    auto hi{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + ((k + 4) * sizeof(RtcpReportBlock)) + offset)) };
+    return _mm256_set_m128i(hi, lo);
+}
+
+[[gnu::target("avx2")]] void DecodeSoAAvx2(const RtcpReportBlock* wire, RtcpReportBlocksSoA& host, size_t count)
+{
+    const auto revWords128{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_revWords.data())) };
+    const auto revWords{ _mm256_set_m128i(revWords128, revWords128) };
+    const auto fraction128{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_fractionBytes.data())) };
+    const auto fractionBytes{ _mm256_set_m128i(fraction128, fraction128) };
+    const auto cumMask{ _mm256_set1_epi32(0x00FFFFFF) };
+
+    size_t i{ 0 };
+    for (; i + 8 <= count; i += 8)
+    {
+        const auto* src{ reinterpret_cast<const uint8_t*>(wire + i) };
+        __m256i lo[4];
+        __m256i hi[4];
+        for (size_t k{ 0 }; k < 4; ++k)
+        {
+            lo[k] = LoadRowPair(src, k, 0);
+            hi[k] = LoadRowPair(src, k, 8);
+        }
+
+        // the unpacks work per lane, each column ends up as blocks 0-3 low and 4-7 high, i.e. in order
+        auto t0{ _mm256_unpacklo_epi32(lo[0], lo[1]) };
+        auto t1{ _mm256_unpacklo_epi32(lo[2], lo[3]) };
+        auto t2{ _mm256_unpackhi_epi32(lo[0], lo[1]) };
+        auto t3{ _mm256_unpackhi_epi32(lo[2], lo[3]) };
+        auto loss{ _mm256_unpackhi_epi64(t0, t1) };
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(&host.ssrc[i]), _mm256_shuffle_epi8(_mm256_unpacklo_epi64(t0, t1), revWords)
+        );
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(&host.cumNumPktsLost[i]),
+            _mm256_and_si256(_mm256_shuffle_epi8(loss, revWords), cumMask)
+        );
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(&host.extHighestSeqNumRx[i]),
+            _mm256_shuffle_epi8(_mm256_unpacklo_epi64(t2, t3), revWords)
+        );
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(&host.intervalJitter[i]),
+            _mm256_shuffle_epi8(_mm256_unpackhi_epi64(t2, t3), revWords)
+        );
+
+        auto fractions{ _mm256_shuffle_epi8(loss, fractionBytes) };
+        auto fractionLo{ _mm_cvtsi128_si32(_mm256_castsi256_si128(fractions)) };
+        auto fractionHi{ _mm_cvtsi128_si32(_mm256_extracti128_si256(fractions, 1)) };
+        std::memcpy(&host.fractionLost[i], &fractionLo, sizeof(fractionLo));
+        std::memcpy(&host.fractionLost[i + 4], &fractionHi, sizeof(fractionHi));
+
+        auto t4{ _mm256_unpackhi_epi32(hi[0], hi[1]) };
+        auto t5{ _mm256_unpackhi_epi32(hi[2], hi[3]) };
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(&host.lastSr[i]), _mm256_shuffle_epi8(_mm256_unpacklo_epi64(t4, t5), revWords)
+        );
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(&host.delayLastSr[i]),
+            _mm256_shuffle_epi8(_mm256_unpackhi_epi64(t4, t5), revWords)
+        );
+    }
+
+    // a trailing group of four still fits the 128-bit path. That code is legacy SSE encoded and GCC emits the tail call
+    // without vzeroupper, so clear the upper halves here to avoid the AVX to SSE transition stall.
+    _mm256_zeroupper();
+    DecodeSoASsse3From(wire, host, i, count);
+}
+
+#endif
+
+using DecodeAoSFn = void (*)(const RtcpReportBlock*, RtcpReportBlock*, size_t);
+using DecodeSoAFn = void (*)(const RtcpReportBlock*, RtcpReportBlocksSoA&, size_t);
+
+struct DecodeImpl
+{
+    RtcpSimdLevel level;
+    DecodeAoSFn aos;
+    DecodeSoAFn soa;
+};
+
+DecodeImpl ImplFor(RtcpSimdLevel level)
+{
+    level = std::min(level, DetectedSimdLevel());
+#if RTP_HAVE_X86_SIMD
+    switch (level)
+    {
+        case RtcpSimdLevel::Avx2:
+        {
+            return DecodeImpl{ .level = level, .aos = DecodeAoSAvx2, .soa = DecodeSoAAvx2 };
+        }
+        case RtcpSimdLevel::Ssse3:
+        {
+            return DecodeImpl{ .level = level, .aos = DecodeAoSSsse3, .soa = DecodeSoASsse3 };
+        }
+        case RtcpSimdLevel::Scalar:
+        {
+            break;
+        }
+    }
+#endif
+    return DecodeImpl{ .level = RtcpSimdLevel::Scalar, .aos = DecodeAoSScalar, .soa = DecodeSoAScalar };
+}
+
+DecodeImpl& ActiveImpl()
+{
+    static DecodeImpl s_impl{ ImplFor(DetectedSimdLevel()) };
+    return s_impl;
+}
+
+} // namespace
+
+RtcpSimdLevel DetectedSimdLevel()
+{
+    static const RtcpSimdLevel s_level{ []
+                                        {
+#if RTP_HAVE_X86_SIMD
+                                            __builtin_cpu_init();
+                                            if (__builtin_cpu_supports("avx2"))
+                                            {
+                                                return RtcpSimdLevel::Avx2;
+                                            }
+                                            if (__builtin_cpu_supports("ssse3"))
+                                            {
+                                                return RtcpSimdLevel::Ssse3;
+                                            }
+#endif
+                                            return RtcpSimdLevel::Scalar;
+                                        }() };
+    return s_level;
+}
+
+RtcpSimdLevel ActiveSimdLevel() { return ActiveImpl().level; }
+
+void ForceSimdLevel(RtcpSimdLevel level) { ActiveImpl() = ImplFor(level); }
+
+void DecodeReportBlocks(std::span<const RtcpReportBlock> wire, std::span<RtcpReportBlock> host)
+{
+    ActiveImpl().aos(wire.data(), host.data(), std::min(wire.size(), host.size()));
+}
+
+void DecodeReportBlocks(std::span<const RtcpReportBlock> wire, RtcpReportBlocksSoA& host)
+{
+    host.count = std::min(wire.size(), RtcpReportBlocksSoA::s_maxBlocks);
+    ActiveImpl().soa(wire.data(), host, host.count);
+}
+
+RtcpSenderReportHeader DecodeSenderInfo(const RtcpSenderReportHeader& wire)
+{
+    // six words, a shuffle would not beat six bswaps here
+    RtcpSenderReportHeader host{ wire };
+    host.cmnHdr.length = be16toh(wire.cmnHdr.length);
+    host.ssrc = be32toh(wire.ssrc);
+    host.ntpTimestampMsb = be32toh(wire.ntpTimestampMsb);
+    host.ntpTimestampLsb = be32toh(wire.ntpTimestampLsb);
+    host.rtpTimestamp = be32toh(wire.rtpTimestamp);
+    host.senderPktCnt = be32toh(wire.senderPktCnt);
+    host.senderOctetCnt = be32toh(wire.senderOctetCnt);
+    return host;
+}
+
+} // namespace rtp
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpSenderRr.hpp"
+
+namespace rtp
+{
+
+/**
+Host byte order report blocks as a struct of arrays, one array per field, for code that scans a single field across
+every block of a report (e.g. all jitter values of a 31 block RR).
+*/
+
+struct RtcpReportBlocksSoA
+{
+    static constexpr size_t s_maxBlocks{ 31 };
+
+    size_t count;
+    std::array<uint32_t, s_maxBlocks> ssrc;
+    std::array<uint8_t, s_maxBlocks> fractionLost;
+    // 24-bit two's complement, as on the wire
+    std::array<uint32_t, s_maxBlocks> cumNumPktsLost;
+    std::array<uint32_t, s_maxBlocks> extHighestSeqNumRx;
+    std::array<uint32_t, s_maxBlocks> intervalJitter;
+    std::array<uint32_t, s_maxBlocks> lastSr;
+    std::array<uint32_t, s_maxBlocks> delayLastSr;
+};
+
+enum class RtcpSimdLevel : uint8_t
+{
+    Scalar,
+    Ssse3,
+    Avx2,
+};
+
+// Best level supported by the running CPU, detected once
+RtcpSimdLevel DetectedSimdLevel();
+
+// Level used by the decoders, defaults to DetectedSimdLevel(). Forcing a level the CPU lacks falls back to the best
+// supported one. Meant for benchmarks and tests, not safe to call while other threads decode.
+RtcpSimdLevel ActiveSimdLevel();
+void ForceSimdLevel(RtcpSimdLevel level);
+
+// Converts wire report blocks to host byte order, AoS to AoS. host must hold at least wire.size() blocks and may alias
+// wire for in-place conversion.
+void DecodeReportBlocks(std::span<const RtcpReportBlock> wire, std::span<RtcpReportBlock> host);
+
+// Converts up to RtcpReportBlocksSoA::s_maxBlocks wire report blocks into host byte order struct of arrays
+void DecodeReportBlocks(std::span<const RtcpReportBlock> wire, RtcpReportBlocksSoA& host);
+
+// Common header and sender info words to host byte order. The common header length becomes host order too, so the
+// result must not be passed to RtcpPktSize.
+RtcpSenderReportHeader DecodeSenderInfo(const RtcpSenderReportHeader& wire);
+
+} // namespace rtp
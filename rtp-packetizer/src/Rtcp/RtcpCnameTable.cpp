@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include "Rtcp/RtcpCnameTable.hpp"
+
+namespace rtp
+{
+
+RtcpCnameTable::RtcpCnameTable(size_t expectedNames) :
+    m_slots(std::bit_ceil(std::max<size_t>(((expectedNames * 4) + 2) / 3, 2)), s_emptySlot),
+    m_mask{ m_slots.size() - 1 }
+{
+    m_hashes.reserve(expectedNames);
+}
+
+size_t RtcpCnameTable::FindSlot(std::string_view cname, size_t hash) const
+{
+    for (size_t slot{ hash & m_mask };; slot = (slot + 1) & m_mask)
+    {
+        Id id{ m_slots[slot] };
+        if (id == s_emptySlot || (m_hashes[id] == hash && m_names[id] == cname))
+        {
+            return slot;
+        }
+    }
+}
+
+RtcpCnameTable::Id RtcpCnameTable::Intern(std::string_view cname)
+{
+    size_t hash{ std::hash<std::string_view>{}(cname) };
+    size_t slot{ FindSlot(cname, hash) };
+    if (m_slots[slot] != s_emptySlot)
+    {
+        return m_slots[slot];
+    }
+
+    // keep the load factor at or below 3/4
+    if ((m_names.size() + 1) * 4 > m_slots.size() * 3)
+    {
+        Grow();
+        slot = FindSlot(cname, hash);
+    }
+
+    auto id{ static_cast<Id>(m_names.size()) };
+    m_names.emplace_back(cname);
+    m_hashes.push_back(hash);
+    m_slots[slot] = id;
+    return id;
+}
+
+std::optional<RtcpCnameTable::Id> RtcpCnameTable::Find(std::string_view cname) const
+{
+    Id id{ m_slots[FindSlot(cname, std::hash<std::string_view>{}(cname))] };
+    if (id == s_emptySlot)
+    {
+        return std::nullopt;
+    }
+
+    return id;
+}
+
+void RtcpCnameTable::Grow()
+{
+    m_slots.assign(m_slots.size() * 2, s_emptySlot);
+    m_mask = m_slots.size() - 1;
+
+    for (Id id{ 0 }; id < m_names.size(); ++id)
+    {
+        size_t slot{ m_hashes[id] & m_mask };
+        while (m_slots[slot] != s_emptySlot)
+        {
+            slot = (slot + 1) & m_mask;
+        }
+        m_slots[slot] = id;
+    }
+}
+
+void RtcpCnameTable::Clear()
+{
+    m_names.clear();
+    m_hashes.clear();
+    std::fill(m_slots.begin(), m_slots.end(), s_emptySlot);
+}
+
+} // namespace rtp
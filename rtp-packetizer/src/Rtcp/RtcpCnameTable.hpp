@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rtp
+{
+
+/**
+Interns SDES CNAMEs, mapping each distinct CNAME to a small stable ID.
+
+Every compound RTCP packet repeats its sender's CNAME, so a receiver sees the same few strings every interval. Lookups
+hash the string_view straight out of the packet and only allocate the first time a CNAME is seen. IDs are dense,
+starting at 0, and stay valid until Clear().
+*/
+
+class RtcpCnameTable
+{
+public:
+    using Id = uint32_t;
+
+    explicit RtcpCnameTable(size_t expectedNames = 64);
+
+    // ID of cname, adding it if not seen before
+    Id Intern(std::string_view cname);
+
+    std::optional<Id> Find(std::string_view cname) const;
+
+    // id must come from this table. Stored names never move, the view stays valid until Clear().
+    std::string_view Name(Id id) const { return m_names[id]; }
+
+    size_t Size() const { return m_names.size(); }
+
+    void Clear();
+
+private:
+    static constexpr Id s_emptySlot{ UINT32_MAX };
+
+    // Slot holding cname, or the empty slot ending its probe chain
+    size_t FindSlot(std::string_view cname, size_t hash) const;
+
+    void Grow();
+
+    // deque so that interning never relocates earlier names
+    std::deque<std::string> m_names;
+    std::vector<size_t> m_hashes;
+    std::vector<Id> m_slots;
+    size_t m_mask;
+};
+
+} // namespace rtp
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace rtp
+{
+
+/**
+Compile-time RTCP packet type dispatch.
+
+Supported sub-packets are a type list of RtcpPktEntry, each naming a packet type, the type it parses into and the
+parser. MakeRtcpDispatchTable turns such a list into a constexpr array of handlers indexed by packet type, so a
+sub-packet costs one bounds check and one indirect call, and types nobody registered or wants fall through a null
+entry. Supporting a new packet type means adding an entry to the list, no switch needs editing.
+*/
+
+// rfc3550 SR (200) up to rfc3611 XR (207)
+constexpr uint8_t s_rtcpFirstDispatchType{ 200 };
+constexpr size_t s_rtcpDispatchTypes{ 8 };
+
+template<uint8_t PktType, typename T, auto Parser>
+struct RtcpPktEntry
+{
+    static_assert(
+        PktType >= s_rtcpFirstDispatchType && PktType < s_rtcpFirstDispatchType + s_rtcpDispatchTypes,
+        "packet type outside the dispatch table"
+    );
+
+    using Type = T;
+
+    static constexpr uint8_t s_pktType{ PktType };
+    static constexpr auto s_parse{ Parser };
+};
+
+template<typename... Entries>
+struct RtcpPktList
+{
+    static constexpr bool UniqueTypes()
+    {
+        std::array<bool, s_rtcpDispatchTypes> seen{};
+        for (auto pktType : { Entries::s_pktType... })
+        {
+            if (seen[pktType - s_rtcpFirstDispatchType])
+            {
+                return false;
+            }
+            seen[pktType - s_rtcpFirstDispatchType] = true;
+        }
+        return true;
+    }
+
+    static_assert(UniqueTypes(), "packet type registered twice");
+};
+
+template<typename Handler>
+using RtcpDispatchTable = std::array<Handler, s_rtcpDispatchTypes>;
+
+// Table with select(std::type_identity<Entry>{}) at each entry's packet type, nullptr elsewhere.
+// select may return nullptr too, to leave a registered type unhandled.
+template<typename Handler, typename... Entries, typename Select>
+constexpr RtcpDispatchTable<Handler> MakeRtcpDispatchTable(RtcpPktList<Entries...> /*entries*/, Select select)
+{
+    RtcpDispatchTable<Handler> table{};
+    ((table[Entries::s_pktType - s_rtcpFirstDispatchType] = select(std::type_identity<Entries>{})), ...);
+    return table;
+}
+
+// Handler for pktType, nullptr for types outside the table or without one
+template<typename Handler>
+constexpr Handler RtcpDispatch(const RtcpDispatchTable<Handler>& table, uint8_t pktType)
+{
+    auto idx{ static_cast<uint8_t>(pktType - s_rtcpFirstDispatchType) };
+    return idx < table.size() ? table[idx] : nullptr;
+}
+
+} // namespace rtp
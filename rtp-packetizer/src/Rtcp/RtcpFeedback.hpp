@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <endian.h>
+#include "Rtcp/RtcpHeader.hpp"
+
+namespace rtp
+{
+
+// rfc4585#section-6.2, FMT values of RTPFB (205)
+enum RtcpRtpFeedbackFmt : uint8_t
+{
+    GenericNack = 1,
+    // draft-holmer-rmcat-transport-wide-cc-extensions-01
+    TransportCc = 15,
+};
+
+// rfc4585#section-6.3 and rfc5104#section-4.3, FMT values of PSFB (206)
+enum RtcpPayloadFeedbackFmt : uint8_t
+{
+    Pli = 1,
+    Fir = 4,
+};
+
+/**
+RTPFB / PSFB: Feedback RTCP Packet
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|V=2|P|   FMT   |       PT      |          length               |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                  SSRC of packet sender                        |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                  SSRC of media source                         |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+:            Feedback Control Information (FCI)                 :
+:                                                               :
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+FMT sits where the other packets keep their count, in cmnHdr.receptionCount.
+*/
+
+struct [[gnu::packed]] RtcpFeedbackHeader
+{
+    RtcpHeader cmnHdr;
+    uint32_t senderSsrc;
+    uint32_t mediaSsrc;
+};
+
+/**
+Generic NACK FCI entry (rfc4585#section-6.2.1)
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|            PID                |             BLP               |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+Bit i of BLP set means PID + i + 1 is lost too.
+*/
+
+struct [[gnu::packed]] RtcpNackItem
+{
+    uint16_t pid;
+    uint16_t blp;
+};
+
+/**
+FIR FCI entry (rfc5104#section-4.3.1). PSFB media SSRC is unused (zero), the target is in the entry.
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                              SSRC                             |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+| Seq nr.       |    Reserved                                   |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+struct [[gnu::packed]] RtcpFirItem
+{
+    uint32_t ssrc;
+    uint8_t seqNr;
+    std::array<uint8_t, 3> reserved;
+};
+
+} // namespace rtp
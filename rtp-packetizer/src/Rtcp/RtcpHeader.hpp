@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <endian.h>
 
@@ -13,6 +14,11 @@ enum RtcpType : uint8_t
     Sdes = 202,
     Bye = 203,
     App = 204,
+    // rfc4585#section-6.1
+    RtpFeedback = 205,
+    PayloadFeedback = 206,
+    // rfc3611#section-2
+    ExtendedReport = 207,
 };
 
 /**
@@ -40,6 +46,10 @@ struct [[gnu::packed]] RtcpHeader
     uint16_t length;
 };
 
+// rfc3550#section-6.4.1
+// length is in 32-bit words minus one, in network byte order
+inline size_t RtcpPktSize(const RtcpHeader& hdr) { return (static_cast<size_t>(be16toh(hdr.length)) + 1) * 4; }
+
 /**
 RTCP Report Block for Sender Report & Receiver Report
 
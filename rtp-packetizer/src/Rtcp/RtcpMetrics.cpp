@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Rtcp/RtcpMetrics.hpp"
+
+namespace rtp
+{
+
+#if RTP_PACKETIZER_METRICS
+
+namespace
+{
+
+// Metrics of threads that exited, plus the live ones
+struct RtcpMetricsRegistry
+{
+    std::mutex mutex;
+    std::vector<detail::RtcpMetricsCells*> live;
+    detail::RtcpMetricsCells retired;
+};
+
+RtcpMetricsRegistry& Registry()
+{
+    // never destroyed, threads may still exit after static destruction began
+    static auto* registry{ new RtcpMetricsRegistry{} };
+    return *registry;
+}
+
+void Add(std::atomic<uint64_t>& into, const std::atomic<uint64_t>& from)
+{
+    into.store(into.load(std::memory_order_relaxed) + from.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+// into is only written under the registry lock
+void Fold(detail::RtcpMetricsCells& into, const detail::RtcpMetricsCells& from)
+{
+    Add(into.compounds, from.compounds);
+    for (size_t i{ 0 }; i < s_rtcpDropReasons; ++i)
+    {
+        Add(into.drops[i], from.drops[i]);
+    }
+    for (size_t type{ 0 }; type < s_rtcpMetricsTypes; ++type)
+    {
+        Add(into.parsed[type], from.parsed[type]);
+        Add(into.malformed[type], from.malformed[type]);
+        Add(into.unsupported[type], from.unsupported[type]);
+        for (size_t bucket{ 0 }; bucket < s_rtcpLatencyBuckets; ++bucket)
+        {
+            Add(into.latency[type][bucket], from.latency[type][bucket]);
+        }
+    }
+}
+
+void Accumulate(RtcpMetricsSnapshot& snapshot, const detail::RtcpMetricsCells& cells)
+{
+    snapshot.compounds += cells.compounds.load(std::memory_order_relaxed);
+    for (size_t i{ 0 }; i < s_rtcpDropReasons; ++i)
+    {
+        snapshot.drops[i] += cells.drops[i].load(std::memory_order_relaxed);
+    }
+    for (size_t type{ 0 }; type < s_rtcpMetricsTypes; ++type)
+    {
+        snapshot.parsed[type] += cells.parsed[type].load(std::memory_order_relaxed);
+        snapshot.malformed[type] += cells.malformed[type].load(std::memory_order_relaxed);
+        snapshot.unsupported[type] += cells.unsupported[type].load(std::memory_order_relaxed);
+        for (size_t bucket{ 0 }; bucket < s_rtcpLatencyBuckets; ++bucket)
+        {
+            snapshot.latency[type].buckets[bucket] += cells.latency[type][bucket].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Owns the calling thread's cells and hands them over to the registry when the thread exits
+struct RtcpMetricsThread
+{
+    std::unique_ptr<detail::RtcpMetricsCells> cells;
+
+    ~RtcpMetricsThread()
+    {
+        if (!cells)
+        {
+            return;
+        }
+
+        auto& registry{ Registry() };
+        std::scoped_lock lock{ registry.mutex };
+        Fold(registry.retired, *cells);
+        std::erase(registry.live, cells.get());
+        detail::t_rtcpMetrics = nullptr;
+    }
+};
+
+thread_local RtcpMetricsThread t_metricsThread;
+
+} // namespace
+
+thread_local constinit detail::RtcpMetricsCells* detail::t_rtcpMetrics{ nullptr };
+
+detail::RtcpMetricsCells& detail::RegisterRtcpMetricsThread()
+{
+    auto& thread{ t_metricsThread };
+    thread.cells = std::make_unique<RtcpMetricsCells>();
+
+    auto& registry{ Registry() };
+    {
+        std::scoped_lock lock{ registry.mutex };
+        registry.live.push_back(thread.cells.get());
+    }
+
+    t_rtcpMetrics = thread.cells.get();
+    return *thread.cells;
+}
+
+void detail::RecordRtcpLatency(RtcpMetricsCells& cells, size_t typeIdx, std::chrono::steady_clock::duration elapsed)
+{
+    auto ns{ static_cast<uint64_t>(std::max<int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 1
+    )) };
+    size_t bucket{ std::min<size_t>(static_cast<size_t>(std::bit_width(ns)) - 1, s_rtcpLatencyBuckets - 1) };
+    BumpCell(cells.latency[typeIdx][bucket]);
+}
+
+#endif
+
+RtcpMetricsSnapshot SnapshotRtcpMetrics()
+{
+    RtcpMetricsSnapshot snapshot{};
+#if RTP_PACKETIZER_METRICS
+    auto& registry{ Registry() };
+    std::scoped_lock lock{ registry.mutex };
+    Accumulate(snapshot, registry.retired);
+    for (const auto* cells : registry.live)
+    {
+        Accumulate(snapshot, *cells);
+    }
+#endif
+    return snapshot;
+}
+
+uint64_t RtcpLatencyHistogram::Count() const
+{
+    uint64_t count{ 0 };
+    for (auto n : buckets)
+    {
+        count += n;
+    }
+    return count;
+}
+
+std::chrono::nanoseconds RtcpLatencyHistogram::Quantile(double q) const
+{
+    uint64_t count{ Count() };
+    if (count == 0)
+    {
+        return std::chrono::nanoseconds{ 0 };
+    }
+
+    auto rank{ static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count))) };
+    uint64_t seen{ 0 };
+    for (size_t bucket{ 0 }; bucket < s_rtcpLatencyBuckets; ++bucket)
+    {
+        seen += buckets[bucket];
+        if (seen >= std::max<uint64_t>(rank, 1))
+        {
+            return std::chrono::nanoseconds{ int64_t{ 1 } << (bucket + 1) };
+        }
+    }
+    return std::chrono::nanoseconds{ int64_t{ 1 } << s_rtcpLatencyBuckets };
+}
+
+} // namespace rtp
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Rtcp/RtcpDispatch.hpp"
+
+// Set to 0 (CMake option RTP_PACKETIZER_METRICS=OFF) to compile every recording call out of the parsers
+#ifndef RTP_PACKETIZER_METRICS
+#define RTP_PACKETIZER_METRICS 1
+#endif
+
+namespace rtp
+{
+
+// Why a compound packet or one of its sub-packets was not parsed
+enum class RtcpDrop : uint8_t
+{
+    Truncated,     // compound rejected, shorter than a common header
+    BadVersion,    // compound rejected, version field is not 2
+    LengthOverrun, // compound rejected, a length field runs past the buffer
+    UnknownType,   // sub-packet skipped, no parser for its type
+    Malformed,     // sub-packet skipped, too short for its type
+};
+
+constexpr size_t s_rtcpDropReasons{ 5 };
+
+// Per-type slots: the dispatchable types 200-207 in order, then one shared by every other type
+constexpr size_t s_rtcpMetricsTypes{ s_rtcpDispatchTypes + 1 };
+
+constexpr size_t RtcpMetricsTypeIdx(uint8_t pktType)
+{
+    size_t idx{ static_cast<uint8_t>(pktType - s_rtcpFirstDispatchType) };
+    return idx < s_rtcpDispatchTypes ? idx : s_rtcpDispatchTypes;
+}
+
+// Bucket i counts parses that took [2^i, 2^(i+1)) ns, the last one everything slower
+constexpr size_t s_rtcpLatencyBuckets{ 24 };
+
+// Each thread times one compound parse in this many, so the clock reads stay off most packets. A power of two, and
+// large enough that the two steady_clock reads of a sample (tens of ns on some VMs) amortize below a nanosecond.
+constexpr uint32_t s_rtcpLatencySampleEvery{ 256 };
+
+struct RtcpLatencyHistogram
+{
+    std::array<uint64_t, s_rtcpLatencyBuckets> buckets{};
+
+    uint64_t Count() const;
+
+    // Upper bound of the bucket holding quantile q in [0, 1], 0 when empty
+    std::chrono::nanoseconds Quantile(double q) const;
+};
+
+struct RtcpMetricsSnapshot
+{
+    // compound packets handed to a parser
+    uint64_t compounds{ 0 };
+    std::array<uint64_t, s_rtcpDropReasons> drops{};
+    // sub-packets parsed, by RtcpMetricsTypeIdx
+    std::array<uint64_t, s_rtcpMetricsTypes> parsed{};
+    // RtcpDrop::Malformed broken down by type
+    std::array<uint64_t, s_rtcpMetricsTypes> malformed{};
+    // well-formed sub-packets skipped because the parser has no packet for their type or format (transport-cc, REMB
+    // or XR in the owned parse), not drops
+    std::array<uint64_t, s_rtcpMetricsTypes> unsupported{};
+    // sampled compound parse time, by the type of the first sub-packet
+    std::array<RtcpLatencyHistogram, s_rtcpMetricsTypes> latency{};
+
+    uint64_t Drops(RtcpDrop reason) const { return drops[static_cast<size_t>(reason)]; }
+};
+
+// Sum over every thread that ever parsed RTCP, running or exited. Takes a lock, meant for periodic export.
+// All zero when built without metrics.
+RtcpMetricsSnapshot SnapshotRtcpMetrics();
+
+namespace detail
+{
+
+// One set per thread, written only by it, so increments are a relaxed load and store rather than a locked RMW
+struct RtcpMetricsCells
+{
+    std::atomic<uint64_t> compounds{ 0 };
+    std::array<std::atomic<uint64_t>, s_rtcpDropReasons> drops{};
+    std::array<std::atomic<uint64_t>, s_rtcpMetricsTypes> parsed{};
+    std::array<std::atomic<uint64_t>, s_rtcpMetricsTypes> malformed{};
+    std::array<std::atomic<uint64_t>, s_rtcpMetricsTypes> unsupported{};
+    std::array<std::array<std::atomic<uint64_t>, s_rtcpLatencyBuckets>, s_rtcpMetricsTypes> latency{};
+};
+
+// constinit lets every access skip the check for a dynamic TLS initializer
+extern thread_local constinit RtcpMetricsCells* t_rtcpMetrics;
+
+// Slow path of the first record on a thread
+RtcpMetricsCells& RegisterRtcpMetricsThread();
+
+inline RtcpMetricsCells& LocalRtcpMetrics()
+{
+    auto* cells{ t_rtcpMetrics };
+    return cells != nullptr ? *cells : RegisterRtcpMetricsThread();
+}
+
+inline void BumpCell(std::atomic<uint64_t>& cell)
+{
+    cell.store(cell.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void RecordRtcpLatency(RtcpMetricsCells& cells, size_t typeIdx, std::chrono::steady_clock::duration elapsed);
+
+} // namespace detail
+
+/**
+Records the outcome of parsing one compound packet into the calling thread's metrics.
+
+Construct one per compound at the start of a parse and report drops and sub-packets through it, the thread's cells are
+looked up once. The first sub-packet reported picks the latency histogram, a compound rejected before that is counted
+but not timed. Every member is empty when built without metrics.
+*/
+
+class RtcpParseScope
+{
+public:
+    RtcpParseScope()
+    {
+#if RTP_PACKETIZER_METRICS
+        m_cells = &detail::LocalRtcpMetrics();
+        // the compound count doubles as the sampling tick
+        uint64_t compounds{ m_cells->compounds.load(std::memory_order_relaxed) + 1 };
+        m_cells->compounds.store(compounds, std::memory_order_relaxed);
+        if (compounds % s_rtcpLatencySampleEvery == 0)
+        {
+            m_start = std::chrono::steady_clock::now();
+            m_sampled = true;
+        }
+#endif
+    }
+
+    RtcpParseScope(const RtcpParseScope&) = delete;
+    RtcpParseScope& operator=(const RtcpParseScope&) = delete;
+
+    ~RtcpParseScope()
+    {
+#if RTP_PACKETIZER_METRICS
+        if (m_sampled && m_typeIdx < s_rtcpMetricsTypes)
+        {
+            detail::RecordRtcpLatency(*m_cells, m_typeIdx, std::chrono::steady_clock::now() - m_start);
+        }
+#endif
+    }
+
+    void Drop([[maybe_unused]] RtcpDrop reason)
+    {
+#if RTP_PACKETIZER_METRICS
+        detail::BumpCell(m_cells->drops[static_cast<size_t>(reason)]);
+#endif
+    }
+
+    void Parsed([[maybe_unused]] uint8_t pktType)
+    {
+#if RTP_PACKETIZER_METRICS
+        auto idx{ SetType(pktType) };
+        detail::BumpCell(m_cells->parsed[idx]);
+#endif
+    }
+
+    void Malformed([[maybe_unused]] uint8_t pktType)
+    {
+#if RTP_PACKETIZER_METRICS
+        auto idx{ SetType(pktType) };
+        detail::BumpCell(m_cells->malformed[idx]);
+        Drop(RtcpDrop::Malformed);
+#endif
+    }
+
+    // Skipped without being a drop, see RtcpMetricsSnapshot::unsupported
+    void Unsupported([[maybe_unused]] uint8_t pktType)
+    {
+#if RTP_PACKETIZER_METRICS
+        auto idx{ SetType(pktType) };
+        detail::BumpCell(m_cells->unsupported[idx]);
+#endif
+    }
+
+    void UnknownType([[maybe_unused]] uint8_t pktType)
+    {
+#if RTP_PACKETIZER_METRICS
+        SetType(pktType);
+        Drop(RtcpDrop::UnknownType);
+#endif
+    }
+
+    // Outcome of a view parser on one sub-packet: no view is malformed for a dispatchable type, unknown for any other
+    void Viewed(uint8_t pktType, bool parsed)
+    {
+        if (parsed)
+        {
+            Parsed(pktType);
+        }
+        else if (RtcpMetricsTypeIdx(pktType) == s_rtcpDispatchTypes)
+        {
+            UnknownType(pktType);
+        }
+        else
+        {
+            Malformed(pktType);
+        }
+    }
+
+    // For parsers that only validate, the compound is timed under its first sub-packet's type
+    void Leading([[maybe_unused]] uint8_t pktType)
+    {
+#if RTP_PACKETIZER_METRICS
+        SetType(pktType);
+#endif
+    }
+
+private:
+#if RTP_PACKETIZER_METRICS
+    size_t SetType(uint8_t pktType)
+    {
+        auto idx{ RtcpMetricsTypeIdx(pktType) };
+        if (m_typeIdx == s_unset)
+        {
+            m_typeIdx = static_cast<uint8_t>(idx);
+        }
+        return idx;
+    }
+
+    static constexpr uint8_t s_unset{ UINT8_MAX };
+
+    detail::RtcpMetricsCells* m_cells;
+    std::chrono::steady_clock::time_point m_start{};
+    uint8_t m_typeIdx{ s_unset };
+    bool m_sampled{ false };
+#endif
+};
+
+} // namespace rtp
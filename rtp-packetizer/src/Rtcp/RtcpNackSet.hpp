@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace rtp
+{
+
+/**
+Lost RTP sequence numbers carried by a generic NACK, as a bitset.
+
+The first sequence number added becomes the base, and the set covers the s_window sequence numbers from there on
+(wrapping at 16 bits). That is all inline storage, nothing is allocated however many packets a NACK names. Sequence
+numbers before the base or past the window are refused, senders list PIDs in ascending order so in practice only a loss
+burst longer than the window gets cut short. Truncated() tells when that happened, e.g. to a parsed NACK.
+*/
+
+class RtcpNackSet
+{
+public:
+    static constexpr size_t s_window{ 512 };
+
+    // false if seq lies outside the window
+    bool Add(uint16_t seq)
+    {
+        if (!m_started)
+        {
+            m_started = true;
+            m_base = seq;
+        }
+
+        auto offset{ static_cast<uint16_t>(seq - m_base) };
+        if (offset >= s_window)
+        {
+            m_truncated = true;
+            return false;
+        }
+
+        m_words[offset / s_wordBits] |= uint64_t{ 1 } << (offset % s_wordBits);
+        return true;
+    }
+
+    // Adds pid and every sequence number blp flags after it (rfc4585#section-6.2.1). false if any fell outside.
+    bool AddItem(uint16_t pid, uint16_t blp)
+    {
+        bool allAdded{ Add(pid) };
+        for (; blp != 0; blp &= static_cast<uint16_t>(blp - 1))
+        {
+            allAdded &= Add(static_cast<uint16_t>(pid + 1 + std::countr_zero(blp)));
+        }
+        return allAdded;
+    }
+
+    bool Contains(uint16_t seq) const
+    {
+        auto offset{ static_cast<uint16_t>(seq - m_base) };
+        return m_started && offset < s_window && IsSet(offset);
+    }
+
+    size_t Count() const
+    {
+        size_t count{ 0 };
+        for (auto word : m_words)
+        {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        return count;
+    }
+
+    bool Empty() const { return Count() == 0; }
+
+    // First sequence number of the window, only meaningful once something was added
+    uint16_t Base() const { return m_base; }
+
+    // Whether an Add was refused since the last Clear, the set then misses some of the sequence numbers given to it
+    bool Truncated() const { return m_truncated; }
+
+    void Clear()
+    {
+        m_words = {};
+        m_base = 0;
+        m_started = false;
+        m_truncated = false;
+    }
+
+    // fn(seq) for every lost sequence number in ascending order from the base
+    template<typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (size_t word{ 0 }; word < s_nWords; ++word)
+        {
+            for (uint64_t bits{ m_words[word] }; bits != 0; bits &= bits - 1)
+            {
+                size_t offset{ (word * s_wordBits) + static_cast<size_t>(std::countr_zero(bits)) };
+                fn(static_cast<uint16_t>(m_base + offset));
+            }
+        }
+    }
+
+    // fn(pid, blp) for the fewest NACK FCI entries covering the set, in ascending order
+    template<typename Fn>
+    void ForEachItem(Fn&& fn) const
+    {
+        auto words{ m_words };
+        for (size_t word{ 0 }; word < s_nWords; ++word)
+        {
+            while (words[word] != 0)
+            {
+                size_t pidOffset{ (word * s_wordBits) + static_cast<size_t>(std::countr_zero(words[word])) };
+                words[word] &= words[word] - 1;
+
+                uint16_t blp{ 0 };
+                for (size_t bit{ 0 }; bit < 16; ++bit)
+                {
+                    size_t offset{ pidOffset + 1 + bit };
+                    if (offset >= s_window)
+                    {
+                        break;
+                    }
+
+                    uint64_t mask{ uint64_t{ 1 } << (offset % s_wordBits) };
+                    if ((words[offset / s_wordBits] & mask) != 0)
+                    {
+                        words[offset / s_wordBits] &= ~mask;
+                        blp = static_cast<uint16_t>(blp | (1U << bit));
+                    }
+                }
+
+                fn(static_cast<uint16_t>(m_base + pidOffset), blp);
+            }
+        }
+    }
+
+    // Number of FCI entries ForEachItem produces
+    size_t ItemCount() const
+    {
+        size_t count{ 0 };
+        ForEachItem([&count](uint16_t /*pid*/, uint16_t /*blp*/) { ++count; });
+        return count;
+    }
+
+private:
+    static constexpr size_t s_wordBits{ 64 };
+    static constexpr size_t s_nWords{ s_window / s_wordBits };
+
+    bool IsSet(size_t offset) const { return ((m_words[offset / s_wordBits] >> (offset % s_wordBits)) & 1) != 0; }
+
+    std::array<uint64_t, s_nWords> m_words{};
+    uint16_t m_base{ 0 };
+    bool m_started{ false };
+    bool m_truncated{ false };
+};
+
+} // namespace rtp
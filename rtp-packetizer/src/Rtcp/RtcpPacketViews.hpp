@@ -0,0 +1,444 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <endian.h>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <variant>
+#include "Rtcp/RtcpApp.hpp"
+#include "Rtcp/RtcpBye.hpp"
+#include "Rtcp/RtcpFeedback.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpNackSet.hpp"
+#include "Rtcp/RtcpReceiverRr.hpp"
+#include "Rtcp/RtcpSdes.hpp"
+#include "Rtcp/RtcpSenderRr.hpp"
+#include "Rtcp/RtcpXr.hpp"
+
+namespace rtp
+{
+
+/**
+Non-owning views into a received RTCP packet.
+
+Every pointer and span refers to the buffer handed to ParseRtcpView, so a view is only valid while that buffer is.
+Header and report block fields are left in network byte order, exactly as they appear on the wire.
+*/
+
+struct RtcpSenderReportView
+{
+    const RtcpSenderReportHeader* header;
+    std::span<const RtcpReportBlock> rrBlocks;
+};
+
+struct RtcpReceiverReportView
+{
+    const RtcpReceiverReportHeader* header;
+    std::span<const RtcpReportBlock> rrBlocks;
+};
+
+/**
+One SDES item. value and prefix point into the packet, prefix is only set for PRIV items.
+*/
+
+struct RtcpSdesItemView
+{
+    // RtcpSdesType, unknown types are passed through for the caller to ignore
+    uint8_t type;
+    std::string_view prefix;
+    std::string_view value;
+};
+
+/**
+Iterates the items of one SDES chunk, up to but excluding its null terminator.
+*/
+
+class RtcpSdesItems
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RtcpSdesItemView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const RtcpSdesItemView*;
+        using reference = const RtcpSdesItemView&;
+
+        Iterator() = default;
+
+        explicit Iterator(std::span<const uint8_t> remaining);
+
+        reference operator*() const { return m_current; }
+
+        pointer operator->() const { return &m_current; }
+
+        Iterator& operator++()
+        {
+            Next();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator prev{ *this };
+            Next();
+            return prev;
+        }
+
+        // only meaningful between iterators of the same chunk
+        bool operator==(const Iterator& other) const { return m_remaining.size() == other.m_remaining.size(); }
+
+    private:
+        void Next();
+
+        std::span<const uint8_t> m_remaining{};
+        size_t m_currentSize{ 0 };
+        RtcpSdesItemView m_current{};
+    };
+
+    explicit RtcpSdesItems(std::span<const uint8_t> items) : m_items{ items } {}
+
+    Iterator begin() const { return Iterator{ m_items }; }
+
+    Iterator end() const { return Iterator{}; }
+
+    // Value of the first item of the given type, if any
+    std::optional<std::string_view> Find(uint8_t type) const;
+
+private:
+    std::span<const uint8_t> m_items;
+};
+
+struct RtcpSdesChunkView
+{
+    // host byte order
+    uint32_t ssrc;
+    // item bytes, without the null terminator and padding
+    std::span<const uint8_t> items;
+
+    RtcpSdesItems Items() const { return RtcpSdesItems{ items }; }
+
+    std::optional<std::string_view> Cname() const { return Items().Find(RtcpSdesType::Cname); }
+};
+
+/**
+Iterates the chunks of an SDES packet, at most as many as its source count says.
+
+Iteration ends early at the first chunk that is truncated, lacks its null terminator, or holds an item running past
+the chunk, so a caller can detect a malformed packet by counting the chunks it saw.
+*/
+
+class RtcpSdesChunks
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RtcpSdesChunkView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const RtcpSdesChunkView*;
+        using reference = const RtcpSdesChunkView&;
+
+        Iterator() = default;
+
+        Iterator(std::span<const uint8_t> remaining, size_t count);
+
+        reference operator*() const { return m_current; }
+
+        pointer operator->() const { return &m_current; }
+
+        Iterator& operator++()
+        {
+            Next();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator prev{ *this };
+            Next();
+            return prev;
+        }
+
+        // only meaningful between iterators of the same packet
+        bool operator==(const Iterator& other) const { return m_remaining.size() == other.m_remaining.size(); }
+
+    private:
+        void Next();
+
+        std::span<const uint8_t> m_remaining{};
+        size_t m_currentSize{ 0 };
+        size_t m_count{ 0 };
+        RtcpSdesChunkView m_current{};
+    };
+
+    RtcpSdesChunks(std::span<const uint8_t> chunks, size_t count) : m_chunks{ chunks }, m_count{ count } {}
+
+    Iterator begin() const { return Iterator{ m_chunks, m_count }; }
+
+    Iterator end() const { return Iterator{}; }
+
+private:
+    std::span<const uint8_t> m_chunks;
+    size_t m_count;
+};
+
+struct RtcpSdesView
+{
+    const RtcpSdesHeader* header;
+    std::span<const uint8_t> chunks;
+
+    RtcpSdesChunks Chunks() const { return RtcpSdesChunks{ chunks, header->cmnHdr.receptionCount }; }
+};
+
+struct RtcpByeView
+{
+    const RtcpByeHeader* header;
+};
+
+struct RtcpAppView
+{
+    const RtcpAppHeader* header;
+    std::span<const uint8_t> data;
+};
+
+/**
+RTPFB: transport layer feedback. fci holds the Feedback Control Information, whatever the format.
+*/
+
+struct RtcpRtpFeedbackView
+{
+    const RtcpFeedbackHeader* header;
+    std::span<const uint8_t> fci;
+
+    // RtcpRtpFeedbackFmt, unknown formats are passed through for the caller to ignore
+    uint8_t Fmt() const { return header->cmnHdr.receptionCount; }
+
+    // Generic NACK entries in network byte order, empty for other formats
+    std::span<const RtcpNackItem> NackItems() const
+    {
+        if (Fmt() != RtcpRtpFeedbackFmt::GenericNack)
+        {
+            return {};
+        }
+        return { reinterpret_cast<const RtcpNackItem*>(fci.data()), fci.size() / sizeof(RtcpNackItem) };
+    }
+
+    // Every sequence number the NACK entries name, Truncated() when some lie past the RtcpNackSet window
+    RtcpNackSet Lost() const
+    {
+        RtcpNackSet lost{};
+        for (const auto& item : NackItems())
+        {
+            lost.AddItem(be16toh(item.pid), be16toh(item.blp));
+        }
+        return lost;
+    }
+};
+
+/**
+PSFB: payload-specific feedback. PLI carries no FCI, FIR one entry per requested source.
+*/
+
+struct RtcpPayloadFeedbackView
+{
+    const RtcpFeedbackHeader* header;
+    std::span<const uint8_t> fci;
+
+    // RtcpPayloadFeedbackFmt, unknown formats are passed through for the caller to ignore
+    uint8_t Fmt() const { return header->cmnHdr.receptionCount; }
+
+    bool IsPli() const { return Fmt() == RtcpPayloadFeedbackFmt::Pli; }
+
+    // FIR entries in network byte order, empty for other formats
+    std::span<const RtcpFirItem> FirItems() const
+    {
+        if (Fmt() != RtcpPayloadFeedbackFmt::Fir)
+        {
+            return {};
+        }
+        return { reinterpret_cast<const RtcpFirItem*>(fci.data()), fci.size() / sizeof(RtcpFirItem) };
+    }
+};
+
+/**
+One XR report block. The typed accessors return nullptr (or an empty span) unless the block is of their type and long
+enough for it. Block fields are in network byte order.
+*/
+
+struct RtcpXrBlockView
+{
+    const RtcpXrBlockHeader* header;
+    // block bytes following the block header
+    std::span<const uint8_t> body;
+
+    // RtcpXrBlockType, unknown types are passed through for the caller to ignore
+    uint8_t Type() const { return header->blockType; }
+
+    const RtcpXrRrtrBlock* Rrtr() const { return As<RtcpXrRrtrBlock>(RtcpXrBlockType::Rrtr); }
+
+    std::span<const RtcpXrDlrrItem> DlrrItems() const
+    {
+        if (Type() != RtcpXrBlockType::Dlrr)
+        {
+            return {};
+        }
+        return { reinterpret_cast<const RtcpXrDlrrItem*>(body.data()), body.size() / sizeof(RtcpXrDlrrItem) };
+    }
+
+    const RtcpXrStatSummaryBlock* StatSummary() const
+    {
+        return As<RtcpXrStatSummaryBlock>(RtcpXrBlockType::StatSummary);
+    }
+
+    const RtcpXrVoipMetricsBlock* VoipMetrics() const
+    {
+        return As<RtcpXrVoipMetricsBlock>(RtcpXrBlockType::VoipMetrics);
+    }
+
+private:
+    template<typename Block>
+    const Block* As(uint8_t type) const
+    {
+        if (Type() != type || sizeof(RtcpXrBlockHeader) + body.size() < sizeof(Block))
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const Block*>(header);
+    }
+};
+
+/**
+Iterates the report blocks of an XR packet, ending early at a block that runs past the packet.
+*/
+
+class RtcpXrBlocks
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RtcpXrBlockView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const RtcpXrBlockView*;
+        using reference = const RtcpXrBlockView&;
+
+        Iterator() = default;
+
+        explicit Iterator(std::span<const uint8_t> remaining);
+
+        reference operator*() const { return m_current; }
+
+        pointer operator->() const { return &m_current; }
+
+        Iterator& operator++()
+        {
+            Next();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator prev{ *this };
+            Next();
+            return prev;
+        }
+
+        // only meaningful between iterators of the same packet
+        bool operator==(const Iterator& other) const { return m_remaining.size() == other.m_remaining.size(); }
+
+    private:
+        void Next();
+
+        std::span<const uint8_t> m_remaining{};
+        size_t m_currentSize{ 0 };
+        RtcpXrBlockView m_current{};
+    };
+
+    explicit RtcpXrBlocks(std::span<const uint8_t> blocks) : m_blocks{ blocks } {}
+
+    Iterator begin() const { return Iterator{ m_blocks }; }
+
+    Iterator end() const { return Iterator{}; }
+
+private:
+    std::span<const uint8_t> m_blocks;
+};
+
+struct RtcpXrView
+{
+    const RtcpXrHeader* header;
+    std::span<const uint8_t> blocks;
+
+    RtcpXrBlocks Blocks() const { return RtcpXrBlocks{ blocks }; }
+};
+
+using RtcpPktView = std::variant<
+    RtcpSenderReportView, RtcpReceiverReportView, RtcpSdesView, RtcpByeView, RtcpAppView, RtcpRtpFeedbackView,
+    RtcpPayloadFeedbackView, RtcpXrView>;
+
+/**
+A validated compound RTCP packet.
+
+Iterating yields one RtcpPktView per recognised sub-packet, skipping unknown types and sub-packets that are too short
+for their type, the same way ParseRtcp does.
+*/
+
+class RtcpCompoundView
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RtcpPktView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const RtcpPktView*;
+        using reference = const RtcpPktView&;
+
+        Iterator() = default;
+
+        explicit Iterator(std::span<const uint8_t> remaining);
+
+        reference operator*() const { return m_current; }
+
+        pointer operator->() const { return &m_current; }
+
+        Iterator& operator++();
+
+        Iterator operator++(int)
+        {
+            Iterator prev{ *this };
+            ++(*this);
+            return prev;
+        }
+
+        // only meaningful between iterators of the same compound packet
+        bool operator==(const Iterator& other) const { return m_remaining.size() == other.m_remaining.size(); }
+
+    private:
+        void SkipToParsable();
+
+        std::span<const uint8_t> m_remaining{};
+        RtcpPktView m_current{};
+    };
+
+    explicit RtcpCompoundView(std::span<const uint8_t> fullPacket) : m_fullPacket{ fullPacket } {}
+
+    Iterator begin() const { return Iterator{ m_fullPacket }; }
+
+    Iterator end() const { return Iterator{}; }
+
+    std::span<const uint8_t> Raw() const { return m_fullPacket; }
+
+private:
+    std::span<const uint8_t> m_fullPacket;
+};
+
+} // namespace rtp
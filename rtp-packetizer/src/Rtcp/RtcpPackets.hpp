@@ -6,7 +6,9 @@
 #include <vector>
 #include "Rtcp/RtcpApp.hpp"
 #include "Rtcp/RtcpBye.hpp"
+#include "Rtcp/RtcpFeedback.hpp"
 #include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpNackSet.hpp"
 #include "Rtcp/RtcpReceiverRr.hpp"
 #include "Rtcp/RtcpSdes.hpp"
 #include "Rtcp/RtcpSenderRr.hpp"
@@ -85,12 +87,18 @@ struct RtcpSdesVariantPriv
 
 using RtcpSdesVariant = std::variant<
     RtcpSdesVariantCname, RtcpSdesVariantUsername, RtcpSdesVariantEmail, RtcpSdesVariantPhone, RtcpSdesVariantLoc,
-    RtcpSdesVariantNote, RtcpSdesVariantPriv>;
+    RtcpSdesVariantTool, RtcpSdesVariantNote, RtcpSdesVariantPriv>;
+
+struct RtcpSdesChunk
+{
+    uint32_t ssrc;
+    std::vector<RtcpSdesVariant> sdeItems;
+};
 
 struct RtcpSdesPkt
 {
     RtcpSdesHeader header;
-    std::vector<RtcpSdesVariant> sdeItems;
+    std::vector<RtcpSdesChunk> chunks;
 };
 
 struct RtcpByePkt
@@ -105,6 +113,23 @@ struct RtcpAppPkt
     std::vector<uint8_t> data;
 };
 
-using RtcpPktVariant = std::variant<RtcpSenderReportPkt, RtcpReceiverReportPkt, RtcpSdesPkt, RtcpByePkt, RtcpAppPkt>;
+// Generic NACK, RTPFB with any other format is skipped. Sequence numbers more than RtcpNackSet::s_window past the first
+// PID do not fit in lost, lost.Truncated() then reports that the NACK asked for more than lost holds.
+struct RtcpNackPkt
+{
+    RtcpFeedbackHeader header;
+    RtcpNackSet lost;
+};
+
+// PLI or FIR, the format is header.cmnHdr.receptionCount. firItems is empty for PLI.
+struct RtcpPayloadFeedbackPkt
+{
+    RtcpFeedbackHeader header;
+    std::vector<RtcpFirItem> firItems;
+};
+
+using RtcpPktVariant = std::variant<
+    RtcpSenderReportPkt, RtcpReceiverReportPkt, RtcpSdesPkt, RtcpByePkt, RtcpAppPkt, RtcpNackPkt,
+    RtcpPayloadFeedbackPkt>;
 
 } // namespace rtp
@@ -3,17 +3,32 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <endian.h>
 #include <optional>
 #include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 #include "Rtcp/RtcpParser.hpp"
+#include "Common/ByteOrder.hpp"
+#include "Common/Expected.hpp"
 #include "Rtcp/RtcpApp.hpp"
 #include "Rtcp/RtcpBye.hpp"
+#include "Rtcp/RtcpByteOrder.hpp"
+#include "Rtcp/RtcpDispatch.hpp"
+#include "Rtcp/RtcpFeedback.hpp"
 #include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpMetrics.hpp"
+#include "Rtcp/RtcpNackSet.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
 #include "Rtcp/RtcpPackets.hpp"
+#include "Rtcp/RtcpReceiverRr.hpp"
 #include "Rtcp/RtcpSdes.hpp"
 #include "Rtcp/RtcpSenderRr.hpp"
+#include "Rtcp/RtcpXr.hpp"
 
 namespace rtp
 {
@@ -28,28 +43,23 @@ std::optional<RtcpSenderReportPkt> ParseSenderReportPkt(PktSpan rawPkt)
         return std::nullopt;
     }
 
-    RtcpSenderReportPkt pkt{};
-    std::memcpy(&pkt.header, rawPkt.data(), sizeof(RtcpSenderReportHeader));
+    const auto* wireHdr{ reinterpret_cast<const RtcpSenderReportHeader*>(rawPkt.data()) };
 
     // max 32 report blocks
-    size_t nRRBlocks{ std::min<size_t>(pkt.header.cmnHdr.receptionCount, 31) };
+    size_t nRRBlocks{ std::min<size_t>(wireHdr->cmnHdr.receptionCount, 31) };
     size_t expectedSizeWithRRBlocks{ (nRRBlocks * sizeof(RtcpReportBlock)) + sizeof(RtcpSenderReportHeader) };
     if (rawPkt.size() < expectedSizeWithRRBlocks)
     {
         return std::nullopt;
     }
 
-    pkt.rrBlocks.reserve(nRRBlocks);
-
-    for (auto itr{ rawPkt.begin() + sizeof(RtcpSenderReportHeader) };
-         itr < rawPkt.begin() + static_cast<DiffSize>(expectedSizeWithRRBlocks);
-         itr += sizeof(RtcpReportBlock))
-    {
-        std::span rawBlock{ itr, itr + sizeof(RtcpReportBlock) };
-        RtcpReportBlock block{};
-        std::memcpy(&block, rawBlock.data(), rawBlock.size());
-        pkt.rrBlocks.emplace_back(block);
-    }
+    RtcpSenderReportPkt pkt{};
+    pkt.header = DecodeSenderInfo(*wireHdr);
+    pkt.rrBlocks.resize(nRRBlocks);
+    DecodeReportBlocks(
+        { reinterpret_cast<const RtcpReportBlock*>(rawPkt.data() + sizeof(RtcpSenderReportHeader)), nRRBlocks },
+        pkt.rrBlocks
+    );
 
     return std::make_optional(std::move(pkt));
 }
@@ -63,6 +73,8 @@ std::optional<RtcpReceiverReportPkt> ParseReceiverReportPkt(PktSpan rawPkt)
 
     RtcpReceiverReportPkt pkt{};
     std::memcpy(&pkt.header, rawPkt.data(), sizeof(RtcpReceiverReportHeader));
+    pkt.header.cmnHdr.length = be16toh(pkt.header.cmnHdr.length);
+    pkt.header.ssrc = be32toh(pkt.header.ssrc);
 
     // max 32 report blocks
     size_t nRRBlocks{ std::min<size_t>(pkt.header.cmnHdr.receptionCount, 31) };
@@ -72,19 +84,57 @@ std::optional<RtcpReceiverReportPkt> ParseReceiverReportPkt(PktSpan rawPkt)
         return std::nullopt;
     }
 
-    pkt.rrBlocks.reserve(nRRBlocks);
+    pkt.rrBlocks.resize(nRRBlocks);
+    DecodeReportBlocks(
+        { reinterpret_cast<const RtcpReportBlock*>(rawPkt.data() + sizeof(RtcpReceiverReportHeader)), nRRBlocks },
+        pkt.rrBlocks
+    );
 
-    for (auto itr{ rawPkt.begin() + sizeof(RtcpReceiverReportHeader) };
-         itr < rawPkt.begin() + static_cast<DiffSize>(expectedSizeWithRRBlocks);
-         itr += sizeof(RtcpReportBlock))
+    return std::make_optional(std::move(pkt));
+}
+
+std::optional<RtcpSdesVariant> MakeSdesVariant(const RtcpSdesItemView& item)
+{
+    switch (item.type)
     {
-        std::span rawBlock{ itr, itr + sizeof(RtcpReportBlock) };
-        RtcpReportBlock block{};
-        std::memcpy(&block, rawBlock.data(), rawBlock.size());
-        pkt.rrBlocks.emplace_back(block);
+        case RtcpSdesType::Cname:
+        {
+            return RtcpSdesVariantCname{ .cname = std::string{ item.value } };
+        }
+        case RtcpSdesType::Username:
+        {
+            return RtcpSdesVariantUsername{ .username = std::string{ item.value } };
+        }
+        case RtcpSdesType::Email:
+        {
+            return RtcpSdesVariantEmail{ .email = std::string{ item.value } };
+        }
+        case RtcpSdesType::Phone:
+        {
+            return RtcpSdesVariantPhone{ .phone = std::string{ item.value } };
+        }
+        case RtcpSdesType::Loc:
+        {
+            return RtcpSdesVariantLoc{ .loc = std::string{ item.value } };
+        }
+        case RtcpSdesType::Tool:
+        {
+            return RtcpSdesVariantTool{ .tool = std::string{ item.value } };
+        }
+        case RtcpSdesType::Note:
+        {
+            return RtcpSdesVariantNote{ .note = std::string{ item.value } };
+        }
+        case RtcpSdesType::Priv:
+        {
+            return RtcpSdesVariantPriv{ .prefixStr = std::string{ item.prefix }, .valStr = std::string{ item.value } };
+        }
+        default:
+        {
+            // rfc3550#section-6.5, unknown items are ignored
+            return std::nullopt;
+        }
     }
-
-    return std::make_optional(std::move(pkt));
 }
 
 std::optional<RtcpSdesPkt> ParseSdesPkt(PktSpan rawPkt)
@@ -94,8 +144,31 @@ std::optional<RtcpSdesPkt> ParseSdesPkt(PktSpan rawPkt)
         return std::nullopt;
     }
 
-    // TODO
-    return std::nullopt;
+    RtcpSdesPkt pkt{};
+    std::memcpy(&pkt.header, rawPkt.data(), sizeof(RtcpSdesHeader));
+    pkt.header.cmnHdr.length = be16toh(pkt.header.cmnHdr.length);
+
+    size_t nChunks{ pkt.header.cmnHdr.receptionCount };
+    pkt.chunks.reserve(nChunks);
+    for (const auto& chunkView : RtcpSdesChunks{ rawPkt.subspan(sizeof(RtcpSdesHeader)), nChunks })
+    {
+        auto& chunk{ pkt.chunks.emplace_back(RtcpSdesChunk{ .ssrc = chunkView.ssrc, .sdeItems = {} }) };
+        for (const auto& item : chunkView.Items())
+        {
+            if (auto variant{ MakeSdesVariant(item) })
+            {
+                chunk.sdeItems.emplace_back(std::move(*variant));
+            }
+        }
+    }
+
+    // chunk iteration stops at the first malformed chunk
+    if (pkt.chunks.size() != nChunks)
+    {
+        return std::nullopt;
+    }
+
+    return std::make_optional(std::move(pkt));
 }
 
 std::optional<RtcpByePkt> ParseByePkt(PktSpan rawPkt)
@@ -107,6 +180,8 @@ std::optional<RtcpByePkt> ParseByePkt(PktSpan rawPkt)
 
     RtcpByePkt pkt{};
     std::memcpy(&pkt.header, rawPkt.data(), sizeof(RtcpByeHeader));
+    pkt.header.cmnHdr.length = be16toh(pkt.header.cmnHdr.length);
+    pkt.header.ssrc = be32toh(pkt.header.ssrc);
     return std::make_optional(pkt);
 }
 
@@ -119,91 +194,627 @@ std::optional<RtcpAppPkt> ParseAppPkt(PktSpan rawPkt)
 
     RtcpAppPkt pkt{};
     std::memcpy(&pkt.header, rawPkt.data(), sizeof(RtcpAppHeader));
+    pkt.header.cmnHdr.length = be16toh(pkt.header.cmnHdr.length);
+    pkt.header.ssrc = be32toh(pkt.header.ssrc);
     pkt.data = { rawPkt.begin() + sizeof(RtcpAppHeader), rawPkt.end() };
 
     return std::make_optional(std::move(pkt));
 }
 
+RtcpFeedbackHeader DecodeFeedbackHeader(PktSpan rawPkt)
+{
+    RtcpFeedbackHeader header{};
+    std::memcpy(&header, rawPkt.data(), sizeof(RtcpFeedbackHeader));
+    header.cmnHdr.length = be16toh(header.cmnHdr.length);
+    header.senderSsrc = be32toh(header.senderSsrc);
+    header.mediaSsrc = be32toh(header.mediaSsrc);
+    return header;
+}
+
+std::optional<RtcpNackPkt> ParseNackPkt(PktSpan rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpFeedbackHeader))
+    {
+        return std::nullopt;
+    }
+
+    RtcpNackPkt pkt{};
+    pkt.header = DecodeFeedbackHeader(rawPkt);
+    if (pkt.header.cmnHdr.receptionCount != RtcpRtpFeedbackFmt::GenericNack)
+    {
+        return std::nullopt;
+    }
+
+    // rfc4585#section-6.2.1, one or more PID/BLP pairs. Entries past the set's window leave it Truncated().
+    size_t nItems{ (rawPkt.size() - sizeof(RtcpFeedbackHeader)) / sizeof(RtcpNackItem) };
+    const uint8_t* fci{ rawPkt.data() + sizeof(RtcpFeedbackHeader) };
+    for (size_t i{ 0 }; i < nItems; ++i, fci += sizeof(RtcpNackItem))
+    {
+        pkt.lost.AddItem(LoadBe16(fci), LoadBe16(fci + 2));
+    }
+
+    if (pkt.lost.Empty())
+    {
+        return std::nullopt;
+    }
+
+    return std::make_optional(pkt);
+}
+
+std::optional<RtcpPayloadFeedbackPkt> ParsePayloadFeedbackPkt(PktSpan rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpFeedbackHeader))
+    {
+        return std::nullopt;
+    }
+
+    RtcpPayloadFeedbackPkt pkt{};
+    pkt.header = DecodeFeedbackHeader(rawPkt);
+    switch (pkt.header.cmnHdr.receptionCount)
+    {
+        case RtcpPayloadFeedbackFmt::Pli:
+        {
+            // rfc4585#section-6.3.1, no FCI
+            break;
+        }
+        case RtcpPayloadFeedbackFmt::Fir:
+        {
+            size_t nItems{ (rawPkt.size() - sizeof(RtcpFeedbackHeader)) / sizeof(RtcpFirItem) };
+            if (nItems == 0)
+            {
+                return std::nullopt;
+            }
+
+            pkt.firItems.resize(nItems);
+            std::memcpy(pkt.firItems.data(), rawPkt.data() + sizeof(RtcpFeedbackHeader), nItems * sizeof(RtcpFirItem));
+            for (auto& item : pkt.firItems)
+            {
+                item.ssrc = be32toh(item.ssrc);
+            }
+            break;
+        }
+        default:
+        {
+            // formats we do not act on are skipped like unknown packet types
+            return std::nullopt;
+        }
+    }
+
+    return std::make_optional(std::move(pkt));
+}
+
+using RtcpOwnedParsers = RtcpPktList<
+    RtcpPktEntry<RtcpType::SenderRR, RtcpSenderReportPkt, &ParseSenderReportPkt>,
+    RtcpPktEntry<RtcpType::ReceiverRR, RtcpReceiverReportPkt, &ParseReceiverReportPkt>,
+    RtcpPktEntry<RtcpType::Sdes, RtcpSdesPkt, &ParseSdesPkt>,
+    RtcpPktEntry<RtcpType::Bye, RtcpByePkt, &ParseByePkt>,
+    RtcpPktEntry<RtcpType::App, RtcpAppPkt, &ParseAppPkt>,
+    RtcpPktEntry<RtcpType::RtpFeedback, RtcpNackPkt, &ParseNackPkt>,
+    RtcpPktEntry<RtcpType::PayloadFeedback, RtcpPayloadFeedbackPkt, &ParsePayloadFeedbackPkt>>;
+
+using OwnedResult = Expected<RtcpPktVariant, RtcpParseStatus>;
+using ParseOwnedFn = OwnedResult (*)(PktSpan, RtcpParseScope&);
+
+// Feedback formats the owned packets carry. Others, like transport-cc or REMB, are well formed but only readable
+// through the views (RtcpTwcc for transport-cc).
+bool IsOwnedFormat(uint8_t pktType, uint8_t fmt)
+{
+    switch (pktType)
+    {
+        case RtcpType::RtpFeedback:
+            return fmt == RtcpRtpFeedbackFmt::GenericNack;
+        case RtcpType::PayloadFeedback:
+            return fmt == RtcpPayloadFeedbackFmt::Pli || fmt == RtcpPayloadFeedbackFmt::Fir;
+        default:
+            return true;
+    }
+}
+
+template<typename Entry>
+OwnedResult ParseOwned(PktSpan rawPkt, RtcpParseScope& scope)
+{
+    // ValidateRtcpSubPacket already checked there is a common header
+    const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(rawPkt.data()) };
+    if (!IsOwnedFormat(Entry::s_pktType, cmnHeader->receptionCount))
+    {
+        scope.Unsupported(Entry::s_pktType);
+        return Unexpected{ RtcpParseStatus::Unsupported };
+    }
+
+    auto pkt{ Entry::s_parse(rawPkt) };
+    if (!pkt)
+    {
+        scope.Malformed(Entry::s_pktType);
+        return Unexpected{ RtcpParseStatus::Malformed };
+    }
+
+    scope.Parsed(Entry::s_pktType);
+    return RtcpPktVariant{ std::move(*pkt) };
+}
+
+constexpr auto s_ownedParseTable{ MakeRtcpDispatchTable<ParseOwnedFn>(
+    RtcpOwnedParsers{}, []<typename Entry>(std::type_identity<Entry> /*entry*/) { return &ParseOwned<Entry>; }
+) };
+
+// A type of the dispatch range without an owned packet (XR) is known, only types outside it are unknown
+RtcpParseStatus SkipUnowned(RtcpParseScope& scope, uint8_t pktType)
+{
+    if (RtcpMetricsTypeIdx(pktType) < s_rtcpDispatchTypes)
+    {
+        scope.Unsupported(pktType);
+        return RtcpParseStatus::Unsupported;
+    }
+
+    scope.UnknownType(pktType);
+    return RtcpParseStatus::UnknownType;
+}
+
 std::vector<RtcpPktVariant> ParseRtcp(const std::vector<uint8_t>& fullPacket)
 {
     std::vector<RtcpPktVariant> res{};
+    RtcpParseScope scope{};
 
     auto pktItr{ fullPacket.begin() };
     while (pktItr < fullPacket.end())
     {
         PktSpan compoundPacket{ pktItr, fullPacket.end() };
-        if (compoundPacket.size() < sizeof(RtcpHeader))
+
+        // rfc3550#section-6.4.1
+        if (auto status{ ValidateRtcpSubPacket(compoundPacket) }; status != RtcpParseStatus::Ok)
         {
+            scope.Drop(RtcpDropOf(status));
             return {};
         }
 
         const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(compoundPacket.data()) };
-        if (cmnHeader->version != 2)
+        auto pktSize{ static_cast<DiffSize>(RtcpPktSize(*cmnHeader)) };
+
+        // each sub-packet only sees its own bytes
+        compoundPacket = { pktItr, pktItr + pktSize };
+
+        // advance
+        pktItr += pktSize;
+
+        // unknown types, types and formats without an owned packet and sub-packets too short for their type are skipped
+        auto parse{ RtcpDispatch(s_ownedParseTable, cmnHeader->pktType) };
+        if (!parse)
         {
-            return {};
+            SkipUnowned(scope, cmnHeader->pktType);
+        }
+        else if (auto pkt{ parse(compoundPacket, scope) })
+        {
+            res.push_back(std::move(pkt.Value()));
         }
+    }
 
-        // rfc3550#section-6.4.1
-        auto pktSize{ static_cast<DiffSize>((cmnHeader->length + 1) * 4) };
-        if ((pktItr + pktSize) > fullPacket.end())
+    return res;
+}
+
+std::vector<RtcpPktResult> ParseRtcpTolerant(std::span<const uint8_t> fullPacket)
+{
+    std::vector<RtcpPktResult> res{};
+    RtcpParseScope scope{};
+
+    size_t offset{ 0 };
+    while (offset < fullPacket.size())
+    {
+        auto remaining{ fullPacket.subspan(offset) };
+
+        // without a trustworthy length there is no next sub-packet to resume at
+        if (auto status{ ValidateRtcpSubPacket(remaining) }; status != RtcpParseStatus::Ok)
         {
-            return {};
+            scope.Drop(RtcpDropOf(status));
+            uint8_t pktType{ remaining.size() >= sizeof(RtcpHeader) ? remaining[1] : uint8_t{ 0 } };
+            res.emplace_back(Unexpected{ RtcpPktError{ offset, pktType, status } });
+            break;
         }
 
-        // advance
-        pktItr += pktSize;
+        const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(remaining.data()) };
+        size_t pktSize{ RtcpPktSize(*cmnHeader) };
+        size_t pktOffset{ offset };
+        offset += pktSize;
 
-        switch (cmnHeader->pktType)
+        auto parse{ RtcpDispatch(s_ownedParseTable, cmnHeader->pktType) };
+        if (!parse)
         {
-            case RtcpType::SenderRR:
-            {
-                if (auto pkt{ ParseSenderReportPkt(compoundPacket) })
-                {
-                    res.emplace_back(std::move(*pkt));
-                }
-                break;
-            }
-            case RtcpType::ReceiverRR:
-            {
-                if (auto pkt{ ParseReceiverReportPkt(compoundPacket) })
-                {
-                    res.emplace_back(std::move(*pkt));
-                }
-                break;
-            }
-            case RtcpType::Sdes:
-            {
-                if (auto pkt{ ParseSdesPkt(compoundPacket) })
-                {
-                    res.emplace_back(std::move(*pkt));
-                }
-                break;
-            }
-            case RtcpType::Bye:
-            {
-                if (auto pkt{ ParseByePkt(compoundPacket) })
-                {
-                    res.emplace_back(*pkt);
-                }
-                break;
-            }
-            case RtcpType::App:
-            {
-                if (auto pkt{ ParseAppPkt(compoundPacket) })
-                {
-                    res.emplace_back(std::move(*pkt));
-                }
-                break;
-            }
-            default:
-            {
-                // skip unknown
-                break;
-            }
+            auto status{ SkipUnowned(scope, cmnHeader->pktType) };
+            res.emplace_back(Unexpected{ RtcpPktError{ pktOffset, cmnHeader->pktType, status } });
+        }
+        else if (auto pkt{ parse(remaining.first(pktSize), scope) })
+        {
+            res.emplace_back(std::move(pkt.Value()));
+        }
+        else
+        {
+            res.emplace_back(Unexpected{ RtcpPktError{ pktOffset, cmnHeader->pktType, pkt.Error() } });
         }
     }
 
     return res;
 }
 
+RtcpParseStatus ValidateRtcpSubPacket(std::span<const uint8_t> remaining)
+{
+    if (remaining.size() < sizeof(RtcpHeader))
+    {
+        return RtcpParseStatus::Truncated;
+    }
+
+    const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(remaining.data()) };
+    if (cmnHeader->version != 2)
+    {
+        return RtcpParseStatus::BadVersion;
+    }
+
+    if (RtcpPktSize(*cmnHeader) > remaining.size())
+    {
+        return RtcpParseStatus::LengthOverrun;
+    }
+
+    return RtcpParseStatus::Ok;
+}
+
+RtcpParseStatus ValidateRtcpCompound(std::span<const uint8_t> fullPacket)
+{
+    size_t offset{ 0 };
+    while (offset < fullPacket.size())
+    {
+        auto remaining{ fullPacket.subspan(offset) };
+        if (auto status{ ValidateRtcpSubPacket(remaining) }; status != RtcpParseStatus::Ok)
+        {
+            return status;
+        }
+
+        offset += RtcpPktSize(*reinterpret_cast<const RtcpHeader*>(remaining.data()));
+    }
+
+    return RtcpParseStatus::Ok;
+}
+
+std::optional<RtcpCompoundView> ParseRtcpView(std::span<const uint8_t> fullPacket)
+{
+    RtcpParseScope scope{};
+    if (auto status{ ValidateRtcpCompound(fullPacket) }; status != RtcpParseStatus::Ok)
+    {
+        scope.Drop(RtcpDropOf(status));
+        return std::nullopt;
+    }
+
+#if RTP_PACKETIZER_METRICS
+    // counted once here like the streaming parse, the returned view may be iterated any number of times
+    size_t offset{ 0 };
+    while (offset < fullPacket.size())
+    {
+        const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(fullPacket.data() + offset) };
+        auto rawPkt{ fullPacket.subspan(offset, RtcpPktSize(*cmnHeader)) };
+        scope.Viewed(cmnHeader->pktType, ParsePktView(rawPkt).has_value());
+        offset += rawPkt.size();
+    }
+#endif
+
+    return std::make_optional<RtcpCompoundView>(fullPacket);
+}
+
+std::optional<RtcpSenderReportView> ParseSenderReportView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpSenderReportHeader))
+    {
+        return std::nullopt;
+    }
+
+    const auto* const header{ reinterpret_cast<const RtcpSenderReportHeader*>(rawPkt.data()) };
+    size_t nRRBlocks{ header->cmnHdr.receptionCount };
+    if (rawPkt.size() < (nRRBlocks * sizeof(RtcpReportBlock)) + sizeof(RtcpSenderReportHeader))
+    {
+        return std::nullopt;
+    }
+
+    const auto* const firstBlock{ reinterpret_cast<const RtcpReportBlock*>(rawPkt.data() + sizeof(*header)) };
+    return RtcpSenderReportView{ .header = header, .rrBlocks = { firstBlock, nRRBlocks } };
+}
+
+std::optional<RtcpReceiverReportView> ParseReceiverReportView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpReceiverReportHeader))
+    {
+        return std::nullopt;
+    }
+
+    const auto* const header{ reinterpret_cast<const RtcpReceiverReportHeader*>(rawPkt.data()) };
+    size_t nRRBlocks{ header->cmnHdr.receptionCount };
+    if (rawPkt.size() < (nRRBlocks * sizeof(RtcpReportBlock)) + sizeof(RtcpReceiverReportHeader))
+    {
+        return std::nullopt;
+    }
+
+    const auto* const firstBlock{ reinterpret_cast<const RtcpReportBlock*>(rawPkt.data() + sizeof(*header)) };
+    return RtcpReceiverReportView{ .header = header, .rrBlocks = { firstBlock, nRRBlocks } };
+}
+
+std::optional<RtcpSdesView> ParseSdesView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpSdesHeader))
+    {
+        return std::nullopt;
+    }
+
+    return RtcpSdesView{
+        .header = reinterpret_cast<const RtcpSdesHeader*>(rawPkt.data()),
+        .chunks = rawPkt.subspan(sizeof(RtcpSdesHeader)),
+    };
+}
+
+std::optional<RtcpByeView> ParseByeView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpByeHeader))
+    {
+        return std::nullopt;
+    }
+
+    return RtcpByeView{ .header = reinterpret_cast<const RtcpByeHeader*>(rawPkt.data()) };
+}
+
+std::optional<RtcpAppView> ParseAppView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpAppHeader))
+    {
+        return std::nullopt;
+    }
+
+    return RtcpAppView{
+        .header = reinterpret_cast<const RtcpAppHeader*>(rawPkt.data()),
+        .data = rawPkt.subspan(sizeof(RtcpAppHeader)),
+    };
+}
+
+std::optional<RtcpRtpFeedbackView> ParseRtpFeedbackView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpFeedbackHeader))
+    {
+        return std::nullopt;
+    }
+
+    return RtcpRtpFeedbackView{
+        .header = reinterpret_cast<const RtcpFeedbackHeader*>(rawPkt.data()),
+        .fci = rawPkt.subspan(sizeof(RtcpFeedbackHeader)),
+    };
+}
+
+std::optional<RtcpPayloadFeedbackView> ParsePayloadFeedbackView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpFeedbackHeader))
+    {
+        return std::nullopt;
+    }
+
+    return RtcpPayloadFeedbackView{
+        .header = reinterpret_cast<const RtcpFeedbackHeader*>(rawPkt.data()),
+        .fci = rawPkt.subspan(sizeof(RtcpFeedbackHeader)),
+    };
+}
+
+std::optional<RtcpXrView> ParseXrView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpXrHeader))
+    {
+        return std::nullopt;
+    }
+
+    return RtcpXrView{
+        .header = reinterpret_cast<const RtcpXrHeader*>(rawPkt.data()),
+        .blocks = rawPkt.subspan(sizeof(RtcpXrHeader)),
+    };
+}
+
+using PktViewFn = std::optional<RtcpPktView> (*)(std::span<const uint8_t>);
+
+template<typename Entry>
+std::optional<RtcpPktView> ToPktView(std::span<const uint8_t> rawPkt)
+{
+    if (auto view{ Entry::s_parse(rawPkt) })
+    {
+        return RtcpPktView{ *view };
+    }
+
+    return std::nullopt;
+}
+
+constexpr auto s_pktViewTable{ MakeRtcpDispatchTable<PktViewFn>(
+    RtcpViewParsers{}, []<typename Entry>(std::type_identity<Entry> /*entry*/) { return &ToPktView<Entry>; }
+) };
+
+std::optional<RtcpPktView> ParsePktView(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RtcpHeader))
+    {
+        return std::nullopt;
+    }
+
+    const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(rawPkt.data()) };
+    if (auto parse{ RtcpDispatch(s_pktViewTable, cmnHeader->pktType) })
+    {
+        return parse(rawPkt);
+    }
+
+    // skip unknown
+    return std::nullopt;
+}
+
+RtcpCompoundView::Iterator::Iterator(std::span<const uint8_t> remaining) : m_remaining{ remaining }
+{
+    SkipToParsable();
+}
+
+RtcpCompoundView::Iterator& RtcpCompoundView::Iterator::operator++()
+{
+    const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(m_remaining.data()) };
+    m_remaining = m_remaining.subspan(RtcpPktSize(*cmnHeader));
+    SkipToParsable();
+    return *this;
+}
+
+void RtcpCompoundView::Iterator::SkipToParsable()
+{
+    // sub-packet bounds were validated by ParseRtcpView
+    while (!m_remaining.empty())
+    {
+        const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(m_remaining.data()) };
+        size_t pktSize{ RtcpPktSize(*cmnHeader) };
+        if (auto view{ ParsePktView(m_remaining.first(pktSize)) })
+        {
+            m_current = *view;
+            return;
+        }
+
+        m_remaining = m_remaining.subspan(pktSize);
+    }
+}
+
+namespace
+{
+
+std::string_view AsText(std::span<const uint8_t> bytes)
+{
+    return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+}
+
+// Size of the SDES item at the front of bytes including its type and length octets, 0 if it runs past bytes or is a
+// PRIV item whose prefix does not fit its length
+size_t SdesItemSize(std::span<const uint8_t> bytes)
+{
+    if (bytes.size() < 2 || bytes.size() < 2 + static_cast<size_t>(bytes[1]))
+    {
+        return 0;
+    }
+
+    if (bytes[0] == RtcpSdesType::Priv && (bytes[1] == 0 || bytes[2] > bytes[1] - 1))
+    {
+        return 0;
+    }
+
+    return 2 + static_cast<size_t>(bytes[1]);
+}
+
+} // namespace
+
+std::optional<std::string_view> RtcpSdesItems::Find(uint8_t type) const
+{
+    for (const auto& item : *this)
+    {
+        if (item.type == type)
+        {
+            return item.value;
+        }
+    }
+
+    return std::nullopt;
+}
+
+RtcpSdesItems::Iterator::Iterator(std::span<const uint8_t> remaining) : m_remaining{ remaining } { Next(); }
+
+void RtcpSdesItems::Iterator::Next()
+{
+    m_remaining = m_remaining.subspan(m_currentSize);
+    m_currentSize = 0;
+
+    if (m_remaining.empty())
+    {
+        return;
+    }
+
+    size_t itemSize{ SdesItemSize(m_remaining) };
+    if (itemSize == 0 || m_remaining.front() == 0)
+    {
+        m_remaining = {};
+        return;
+    }
+
+    auto text{ m_remaining.subspan(2, itemSize - 2) };
+    m_current = RtcpSdesItemView{ .type = m_remaining.front(), .prefix = {}, .value = AsText(text) };
+    if (m_current.type == RtcpSdesType::Priv)
+    {
+        // prefix length octet, prefix, value
+        size_t prefixSize{ text.front() };
+        m_current.prefix = AsText(text.subspan(1, prefixSize));
+        m_current.value = AsText(text.subspan(1 + prefixSize));
+    }
+
+    m_currentSize = itemSize;
+}
+
+RtcpSdesChunks::Iterator::Iterator(std::span<const uint8_t> remaining, size_t count) :
+    m_remaining{ remaining },
+    m_count{ count }
+{
+    Next();
+}
+
+void RtcpSdesChunks::Iterator::Next()
+{
+    m_remaining = m_remaining.subspan(m_currentSize);
+    m_currentSize = 0;
+
+    if (m_count == 0 || m_remaining.size() < sizeof(uint32_t))
+    {
+        m_remaining = {};
+        return;
+    }
+    --m_count;
+
+    // rfc3550#section-6.5, items run up to a null octet, then the chunk is padded to the next 32-bit boundary
+    size_t offset{ sizeof(uint32_t) };
+    while (offset < m_remaining.size() && m_remaining[offset] != 0)
+    {
+        size_t itemSize{ SdesItemSize(m_remaining.subspan(offset)) };
+        if (itemSize == 0)
+        {
+            m_remaining = {};
+            return;
+        }
+        offset += itemSize;
+    }
+
+    size_t chunkSize{ (offset + 1 + 3) & ~size_t{ 3 } };
+    if (offset >= m_remaining.size() || chunkSize > m_remaining.size())
+    {
+        m_remaining = {};
+        return;
+    }
+
+    m_current = RtcpSdesChunkView{
+        .ssrc = LoadBe32(m_remaining.data()),
+        .items = m_remaining.subspan(sizeof(uint32_t), offset - sizeof(uint32_t)),
+    };
+    m_currentSize = chunkSize;
+}
+
+RtcpXrBlocks::Iterator::Iterator(std::span<const uint8_t> remaining) : m_remaining{ remaining } { Next(); }
+
+void RtcpXrBlocks::Iterator::Next()
+{
+    m_remaining = m_remaining.subspan(m_currentSize);
+    m_currentSize = 0;
+
+    if (m_remaining.size() < sizeof(RtcpXrBlockHeader))
+    {
+        m_remaining = {};
+        return;
+    }
+
+    // rfc3611#section-3, block length is in 32-bit words minus one, header included
+    const auto* const header{ reinterpret_cast<const RtcpXrBlockHeader*>(m_remaining.data()) };
+    size_t blockSize{ (static_cast<size_t>(be16toh(header->length)) + 1) * 4 };
+    if (blockSize > m_remaining.size())
+    {
+        m_remaining = {};
+        return;
+    }
+
+    m_current = RtcpXrBlockView{
+        .header = header,
+        .body = m_remaining.subspan(sizeof(RtcpXrBlockHeader), blockSize - sizeof(RtcpXrBlockHeader)),
+    };
+    m_currentSize = blockSize;
+}
+
 } // namespace rtp
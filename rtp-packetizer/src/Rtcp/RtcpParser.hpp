@@ -1,10 +1,230 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Common/Expected.hpp"
+#include "Rtcp/RtcpDispatch.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpMetrics.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
 #include "Rtcp/RtcpPackets.hpp"
 
 namespace rtp
 {
 
+// Owning parse, every field of the returned packets is in host byte order
 std::vector<RtcpPktVariant> ParseRtcp(const std::vector<uint8_t>& fullPacket);
 
+// Validates every sub-packet header of the compound packet once, without allocating.
+// Returns std::nullopt for the same malformed inputs ParseRtcp rejects. A valid compound has each of its sub-packets
+// recorded in the thread's RTCP metrics up front, the views the iterator yields are not counted again.
+std::optional<RtcpCompoundView> ParseRtcpView(std::span<const uint8_t> fullPacket);
+
+// Per sub-packet view parsers. rawPkt must span exactly one sub-packet.
+std::optional<RtcpSenderReportView> ParseSenderReportView(std::span<const uint8_t> rawPkt);
+std::optional<RtcpReceiverReportView> ParseReceiverReportView(std::span<const uint8_t> rawPkt);
+std::optional<RtcpSdesView> ParseSdesView(std::span<const uint8_t> rawPkt);
+std::optional<RtcpByeView> ParseByeView(std::span<const uint8_t> rawPkt);
+std::optional<RtcpAppView> ParseAppView(std::span<const uint8_t> rawPkt);
+std::optional<RtcpRtpFeedbackView> ParseRtpFeedbackView(std::span<const uint8_t> rawPkt);
+std::optional<RtcpPayloadFeedbackView> ParsePayloadFeedbackView(std::span<const uint8_t> rawPkt);
+std::optional<RtcpXrView> ParseXrView(std::span<const uint8_t> rawPkt);
+std::optional<RtcpPktView> ParsePktView(std::span<const uint8_t> rawPkt);
+
+// Sub-packet views understood by ParseRtcpView, ParsePktView and the streaming ParseRtcp
+using RtcpViewParsers = RtcpPktList<
+    RtcpPktEntry<RtcpType::SenderRR, RtcpSenderReportView, &ParseSenderReportView>,
+    RtcpPktEntry<RtcpType::ReceiverRR, RtcpReceiverReportView, &ParseReceiverReportView>,
+    RtcpPktEntry<RtcpType::Sdes, RtcpSdesView, &ParseSdesView>,
+    RtcpPktEntry<RtcpType::Bye, RtcpByeView, &ParseByeView>,
+    RtcpPktEntry<RtcpType::App, RtcpAppView, &ParseAppView>,
+    RtcpPktEntry<RtcpType::RtpFeedback, RtcpRtpFeedbackView, &ParseRtpFeedbackView>,
+    RtcpPktEntry<RtcpType::PayloadFeedback, RtcpPayloadFeedbackView, &ParsePayloadFeedbackView>,
+    RtcpPktEntry<RtcpType::ExtendedReport, RtcpXrView, &ParseXrView>>;
+
+enum class RtcpParseStatus : uint8_t
+{
+    Ok,
+    Truncated,     // shorter than a common header
+    BadVersion,    // version field is not 2
+    LengthOverrun, // length field runs past the end of the buffer
+    // sub-packet failures, only reported per sub-packet by ParseRtcpTolerant
+    UnknownType, // packet type outside rfc3550 and its extensions up to XR
+    Malformed,   // too short for its declared type or feedback format
+    Unsupported, // well formed, but no owned packet for its type or format (transport-cc, REMB, XR)
+};
+
+// Unsupported sub-packets are skipped rather than dropped, there is no RtcpDrop for them
+constexpr RtcpDrop RtcpDropOf(RtcpParseStatus status)
+{
+    switch (status)
+    {
+        case RtcpParseStatus::Truncated:
+            return RtcpDrop::Truncated;
+        case RtcpParseStatus::BadVersion:
+            return RtcpDrop::BadVersion;
+        case RtcpParseStatus::UnknownType:
+            return RtcpDrop::UnknownType;
+        case RtcpParseStatus::Malformed:
+            return RtcpDrop::Malformed;
+        default:
+            return RtcpDrop::LengthOverrun;
+    }
+}
+
+// Checks the common header at the front of remaining: enough bytes for it, version 2 and a length that fits.
+RtcpParseStatus ValidateRtcpSubPacket(std::span<const uint8_t> remaining);
+
+// Walks only the common headers: version, and that every sub-packet length fits in the buffer.
+// Returns the failure of the first sub-packet that does not pass ValidateRtcpSubPacket.
+RtcpParseStatus ValidateRtcpCompound(std::span<const uint8_t> fullPacket);
+
+inline bool IsValidRtcpCompound(std::span<const uint8_t> fullPacket)
+{
+    return ValidateRtcpCompound(fullPacket) == RtcpParseStatus::Ok;
+}
+
+// Where and why a sub-packet of ParseRtcpTolerant was not parsed
+struct RtcpPktError
+{
+    // byte offset of the sub-packet in the compound packet
+    size_t offset;
+    // 0 when the common header itself could not be read
+    uint8_t pktType;
+    RtcpParseStatus reason;
+};
+
+using RtcpPktResult = Expected<RtcpPktVariant, RtcpPktError>;
+
+/**
+Owning parse that keeps the good parts of a damaged compound packet, one result per sub-packet in wire order.
+
+Where ParseRtcp silently skips them, a sub-packet that is malformed, unsupported or of an unknown type gets its own
+error result saying why, and an SR next to a broken feedback packet still yields its timing. Unsupported is not a fault
+of the peer: the sub-packet is well formed but only readable through the views, e.g. transport-cc with ParseTwcc. A
+common header that is truncated, has a bad version or a length running past the buffer leaves the rest unframeable: it
+ends the parse with a last error result, the sub-packets before it are kept.
+*/
+std::vector<RtcpPktResult> ParseRtcpTolerant(std::span<const uint8_t> fullPacket);
+
+// Returned by a visitor handler to control the streaming parse. Handlers may also return void to always continue.
+enum class RtcpVisit : uint8_t
+{
+    Continue,
+    Stop,
+};
+
+namespace detail
+{
+
+template<typename Visitor, typename View>
+bool VisitRtcpPkt(Visitor& visitor, std::optional<View> view, RtcpParseScope& scope, uint8_t pktType)
+{
+    if (!view)
+    {
+        // too short for its type, skip like ParseRtcp
+        scope.Malformed(pktType);
+        return true;
+    }
+
+    scope.Parsed(pktType);
+
+    if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, const View&>, RtcpVisit>)
+    {
+        return std::invoke(visitor, std::as_const(*view)) == RtcpVisit::Continue;
+    }
+    else
+    {
+        std::invoke(visitor, std::as_const(*view));
+        return true;
+    }
 }
+
+template<typename Visitor, typename Entry>
+bool ParseAndVisit(Visitor& visitor, std::span<const uint8_t> rawPkt, RtcpParseScope& scope)
+{
+    return VisitRtcpPkt(visitor, Entry::s_parse(rawPkt), scope, Entry::s_pktType);
+}
+
+template<typename Visitor>
+using RtcpVisitFn = bool (*)(Visitor&, std::span<const uint8_t>, RtcpParseScope&);
+
+// Per visitor type, parse-and-visit entries only for the views it is invocable with
+template<typename Visitor>
+constexpr auto s_rtcpVisitTable{ MakeRtcpDispatchTable<RtcpVisitFn<Visitor>>(
+    RtcpViewParsers{},
+    []<typename Entry>(std::type_identity<Entry> /*entry*/) -> RtcpVisitFn<Visitor>
+    {
+        if constexpr (std::is_invocable_v<Visitor&, const typename Entry::Type&>)
+        {
+            return &ParseAndVisit<Visitor, Entry>;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+) };
+
+} // namespace detail
+
+/**
+Streaming parse of a compound RTCP packet.
+
+The visitor is invoked with a `const RtcpXxxView&` for each sub-packet as it is walked, in packet order. Only the view
+types the visitor is invocable with are parsed at all, other sub-packets are stepped over by their length. Dispatch
+goes through a per-visitor table built at compile time from RtcpViewParsers.
+A handler returning RtcpVisit::Stop ends the walk early.
+
+Sub-packet headers are validated up front, so on malformed input no handler is invoked and false is returned.
+Outcomes are recorded in the thread's RTCP metrics, skipped types are neither parsed nor counted.
+*/
+template<typename Visitor>
+bool ParseRtcp(std::span<const uint8_t> fullPacket, Visitor&& visitor)
+{
+    RtcpParseScope scope{};
+    if (auto status{ ValidateRtcpCompound(fullPacket) }; status != RtcpParseStatus::Ok)
+    {
+        scope.Drop(RtcpDropOf(status));
+        return false;
+    }
+
+    // the compound is timed under its first sub-packet's type, whether the visitor takes it or not
+    if (!fullPacket.empty())
+    {
+        scope.Leading(reinterpret_cast<const RtcpHeader*>(fullPacket.data())->pktType);
+    }
+
+    size_t offset{ 0 };
+    while (offset < fullPacket.size())
+    {
+        const auto* const cmnHeader{ reinterpret_cast<const RtcpHeader*>(fullPacket.data() + offset) };
+        auto rawPkt{ fullPacket.subspan(offset, RtcpPktSize(*cmnHeader)) };
+
+        // advance
+        offset += rawPkt.size();
+
+        // types the visitor takes no view for have a null entry and are stepped over
+        if (auto handler{ RtcpDispatch(detail::s_rtcpVisitTable<std::remove_reference_t<Visitor>>, cmnHeader->pktType) })
+        {
+            if (!handler(visitor, rawPkt, scope))
+            {
+                break;
+            }
+        }
+        else if (RtcpMetricsTypeIdx(cmnHeader->pktType) == s_rtcpDispatchTypes)
+        {
+            scope.UnknownType(cmnHeader->pktType);
+        }
+    }
+
+    return true;
+}
+
+} // namespace rtp
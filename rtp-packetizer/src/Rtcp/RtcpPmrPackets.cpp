@@ -0,0 +1,152 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <endian.h>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Rtcp/RtcpPmrPackets.hpp"
+#include "Rtcp/RtcpByteOrder.hpp"
+#include "Rtcp/RtcpFeedback.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtcp/RtcpParser.hpp"
+
+namespace rtp::pmr
+{
+
+namespace
+{
+
+// Streaming parse visitor turning each view into its owned counterpart on the output's resource
+struct PmrPktBuilder
+{
+    std::pmr::vector<RtcpPktVariant>& out;
+    std::pmr::memory_resource* mr;
+
+    void operator()(const RtcpSenderReportView& view)
+    {
+        RtcpSenderReportPkt pkt{
+            .header = DecodeSenderInfo(*view.header),
+            .rrBlocks = std::pmr::vector<RtcpReportBlock>{ mr },
+        };
+        pkt.rrBlocks.resize(view.rrBlocks.size());
+        DecodeReportBlocks(view.rrBlocks, pkt.rrBlocks);
+        out.emplace_back(std::move(pkt));
+    }
+
+    void operator()(const RtcpReceiverReportView& view)
+    {
+        RtcpReceiverReportPkt pkt{ .header{}, .rrBlocks = std::pmr::vector<RtcpReportBlock>{ mr } };
+        std::memcpy(&pkt.header, view.header, sizeof(RtcpReceiverReportHeader));
+        pkt.header.cmnHdr.length = be16toh(pkt.header.cmnHdr.length);
+        pkt.header.ssrc = be32toh(pkt.header.ssrc);
+        pkt.rrBlocks.resize(view.rrBlocks.size());
+        DecodeReportBlocks(view.rrBlocks, pkt.rrBlocks);
+        out.emplace_back(std::move(pkt));
+    }
+
+    void operator()(const RtcpSdesView& view)
+    {
+        RtcpSdesPkt pkt{ .header{}, .chunks = std::pmr::vector<RtcpSdesChunk>{ mr } };
+        std::memcpy(&pkt.header, view.header, sizeof(RtcpSdesHeader));
+        pkt.header.cmnHdr.length = be16toh(pkt.header.cmnHdr.length);
+
+        size_t nChunks{ pkt.header.cmnHdr.receptionCount };
+        pkt.chunks.reserve(nChunks);
+        for (const auto& chunkView : view.Chunks())
+        {
+            auto& chunk{ pkt.chunks.emplace_back(
+                RtcpSdesChunk{ .ssrc = chunkView.ssrc, .sdeItems = std::pmr::vector<RtcpSdesItem>{ mr } }
+            ) };
+            for (const auto& item : chunkView.Items())
+            {
+                // rfc3550#section-6.5, unknown items are ignored
+                if (item.type < RtcpSdesType::Cname || item.type > RtcpSdesType::Priv)
+                {
+                    continue;
+                }
+
+                chunk.sdeItems.emplace_back(RtcpSdesItem{
+                    .type = item.type,
+                    .prefix = std::pmr::string{ item.prefix, mr },
+                    .value = std::pmr::string{ item.value, mr },
+                });
+            }
+        }
+
+        // chunk iteration stops at the first malformed chunk, drop the packet like rtp::ParseRtcp
+        if (pkt.chunks.size() == nChunks)
+        {
+            out.emplace_back(std::move(pkt));
+        }
+    }
+
+    void operator()(const RtcpByeView& view)
+    {
+        RtcpByePkt pkt{};
+        std::memcpy(&pkt.header, view.header, sizeof(RtcpByeHeader));
+        pkt.header.cmnHdr.length = be16toh(pkt.header.cmnHdr.length);
+        pkt.header.ssrc = be32toh(pkt.header.ssrc);
+        out.emplace_back(pkt);
+    }
+
+    void operator()(const RtcpAppView& view)
+    {
+        RtcpAppPkt pkt{ .header{}, .data{ view.data.begin(), view.data.end(), mr } };
+        std::memcpy(&pkt.header, view.header, sizeof(RtcpAppHeader));
+        pkt.header.cmnHdr.length = be16toh(pkt.header.cmnHdr.length);
+        pkt.header.ssrc = be32toh(pkt.header.ssrc);
+        out.emplace_back(std::move(pkt));
+    }
+
+    void operator()(const RtcpRtpFeedbackView& view)
+    {
+        if (view.Fmt() != RtcpRtpFeedbackFmt::GenericNack || view.NackItems().empty())
+        {
+            return;
+        }
+
+        out.emplace_back(RtcpNackPkt{ .header = DecodeFeedbackHeader(*view.header), .lost = view.Lost() });
+    }
+
+    void operator()(const RtcpPayloadFeedbackView& view)
+    {
+        if (!view.IsPli() && view.FirItems().empty())
+        {
+            return;
+        }
+
+        RtcpPayloadFeedbackPkt pkt{
+            .header = DecodeFeedbackHeader(*view.header),
+            .firItems = std::pmr::vector<RtcpFirItem>{ mr },
+        };
+        pkt.firItems.reserve(view.FirItems().size());
+        for (auto item : view.FirItems())
+        {
+            item.ssrc = be32toh(item.ssrc);
+            pkt.firItems.push_back(item);
+        }
+        out.emplace_back(std::move(pkt));
+    }
+
+    static RtcpFeedbackHeader DecodeFeedbackHeader(const RtcpFeedbackHeader& wire)
+    {
+        RtcpFeedbackHeader header{ wire };
+        header.cmnHdr.length = be16toh(header.cmnHdr.length);
+        header.senderSsrc = be32toh(header.senderSsrc);
+        header.mediaSsrc = be32toh(header.mediaSsrc);
+        return header;
+    }
+};
+
+} // namespace
+
+bool ParseRtcp(std::span<const uint8_t> fullPacket, std::pmr::vector<RtcpPktVariant>& out)
+{
+    // the streaming parse validates every header before the first handler runs
+    return rtp::ParseRtcp(fullPacket, PmrPktBuilder{ .out = out, .mr = out.get_allocator().resource() });
+}
+
+} // namespace rtp::pmr
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+#include "Rtcp/RtcpApp.hpp"
+#include "Rtcp/RtcpFeedback.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpPackets.hpp"
+#include "Rtcp/RtcpReceiverRr.hpp"
+#include "Rtcp/RtcpSdes.hpp"
+#include "Rtcp/RtcpSenderRr.hpp"
+
+namespace rtp::pmr
+{
+
+/**
+Owning RTCP packets whose memory comes from a std::pmr::memory_resource.
+
+Same shape and host byte order as RtcpPackets.hpp, except SDES items are kept as type/prefix/value like RtcpSdesItemView
+rather than one struct per type. Every nested container is built on the resource of the output vector, so backing that
+with e.g. a std::pmr::monotonic_buffer_resource over a PacketBuffer keeps the owned parse off the heap entirely.
+*/
+
+struct RtcpSenderReportPkt
+{
+    RtcpSenderReportHeader header;
+    std::pmr::vector<RtcpReportBlock> rrBlocks;
+};
+
+struct RtcpReceiverReportPkt
+{
+    RtcpReceiverReportHeader header;
+    std::pmr::vector<RtcpReportBlock> rrBlocks;
+};
+
+struct RtcpSdesItem
+{
+    // RtcpSdesType, items of unknown type are dropped
+    uint8_t type;
+    // only set for PRIV items
+    std::pmr::string prefix;
+    std::pmr::string value;
+};
+
+struct RtcpSdesChunk
+{
+    uint32_t ssrc;
+    std::pmr::vector<RtcpSdesItem> sdeItems;
+};
+
+struct RtcpSdesPkt
+{
+    RtcpSdesHeader header;
+    std::pmr::vector<RtcpSdesChunk> chunks;
+};
+
+struct RtcpAppPkt
+{
+    RtcpAppHeader header;
+    std::pmr::vector<uint8_t> data;
+};
+
+struct RtcpPayloadFeedbackPkt
+{
+    RtcpFeedbackHeader header;
+    std::pmr::vector<RtcpFirItem> firItems;
+};
+
+// BYE and NACK own no memory, the regular structs are reused
+using RtcpByePkt = rtp::RtcpByePkt;
+using RtcpNackPkt = rtp::RtcpNackPkt;
+
+using RtcpPktVariant = std::variant<
+    RtcpSenderReportPkt, RtcpReceiverReportPkt, RtcpSdesPkt, RtcpByePkt, RtcpAppPkt, RtcpNackPkt,
+    RtcpPayloadFeedbackPkt>;
+
+// Owning parse into out, allocating from out's memory resource. Sub-packets are appended in packet order, skipping the
+// same ones rtp::ParseRtcp does. On malformed input nothing is appended and false is returned.
+bool ParseRtcp(std::span<const uint8_t> fullPacket, std::pmr::vector<RtcpPktVariant>& out);
+
+} // namespace rtp::pmr
@@ -1,3 +1,6 @@
+#pragma once
+
+#include <cstdint>
 #include <endian.h>
 #include "Rtcp/RtcpHeader.hpp"
 
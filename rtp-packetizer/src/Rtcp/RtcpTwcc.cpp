@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include "Rtcp/RtcpTwcc.hpp"
+#include "Common/ByteOrder.hpp"
+#include "Rtcp/RtcpFeedback.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtcp/RtcpWriter.hpp"
+
+namespace rtp
+{
+
+namespace
+{
+
+constexpr size_t s_fixedFciSize{ 8 };
+constexpr int64_t s_refTimeUs{ 64'000 };
+constexpr int64_t s_deltaUs{ 250 };
+constexpr int64_t s_deltaTicksPerRef{ s_refTimeUs / s_deltaUs };
+
+// Packet status symbols, also the number of receive delta octets each one carries
+constexpr uint8_t s_notReceived{ 0 };
+constexpr uint8_t s_smallDelta{ 1 };
+constexpr uint8_t s_largeDelta{ 2 };
+constexpr uint8_t s_reservedSymbol{ 3 };
+
+constexpr uint16_t s_maxRunLength{ 0x1FFF };
+constexpr size_t s_oneBitSymbols{ 14 };
+constexpr size_t s_twoBitSymbols{ 7 };
+
+constexpr size_t PadTo32(size_t size) { return (size + 3) & ~size_t{ 3 }; }
+
+int32_t SignExtend24(uint32_t val) { return static_cast<int32_t>(val << 8) >> 8; }
+
+// Greedy chunk encoding: a run-length chunk for runs of 7 or more (or the tail), otherwise a one-bit status vector when
+// the next 14 symbols allow it and a two-bit one when not. Returns the number of chunks, written to dst if not null.
+size_t EncodeChunks(std::span<const uint8_t> symbols, uint8_t* dst)
+{
+    size_t nChunks{ 0 };
+    size_t i{ 0 };
+    while (i < symbols.size())
+    {
+        size_t run{ 1 };
+        while (i + run < symbols.size() && symbols[i + run] == symbols[i] && run < s_maxRunLength)
+        {
+            ++run;
+        }
+
+        uint16_t chunk{ 0 };
+        if (run >= s_twoBitSymbols || i + run == symbols.size())
+        {
+            chunk = static_cast<uint16_t>((symbols[i] << 13) | run);
+            i += run;
+        }
+        else
+        {
+            size_t n{ std::min(s_oneBitSymbols, symbols.size() - i) };
+            auto next{ symbols.subspan(i, n) };
+            if (std::all_of(next.begin(), next.end(), [](uint8_t sym) { return sym <= s_smallDelta; }))
+            {
+                chunk = 0x8000;
+                for (size_t k{ 0 }; k < n; ++k)
+                {
+                    chunk = static_cast<uint16_t>(chunk | (next[k] << (13 - k)));
+                }
+            }
+            else
+            {
+                n = std::min(s_twoBitSymbols, n);
+                chunk = 0xC000;
+                for (size_t k{ 0 }; k < n; ++k)
+                {
+                    chunk = static_cast<uint16_t>(chunk | (next[k] << (12 - (2 * k))));
+                }
+            }
+            i += n;
+        }
+
+        if (dst != nullptr)
+        {
+            StoreBe16(dst + (nChunks * sizeof(uint16_t)), chunk);
+        }
+        ++nChunks;
+    }
+
+    return nChunks;
+}
+
+} // namespace
+
+std::optional<RtcpTwccFeedback> ParseTwcc(std::span<const uint8_t> fci, std::span<int64_t> arrivalsUs)
+{
+    if (fci.size() < s_fixedFciSize)
+    {
+        return std::nullopt;
+    }
+
+    RtcpTwccFeedback feedback{
+        .baseSeq = LoadBe16(fci.data()),
+        .statusCount = LoadBe16(fci.data() + 2),
+        .referenceTime = SignExtend24(LoadBe24(fci.data() + 4)),
+        .fbPktCount = fci[7],
+    };
+
+    size_t count{ feedback.statusCount };
+    if (count > arrivalsUs.size())
+    {
+        return std::nullopt;
+    }
+
+    // first pass expands the chunks into one symbol per packet, stored in the output until the deltas replace them
+    size_t offset{ s_fixedFciSize };
+    size_t nDeltaBytes{ 0 };
+    bool reserved{ false };
+    size_t i{ 0 };
+    while (i < count)
+    {
+        if (offset + sizeof(uint16_t) > fci.size())
+        {
+            return std::nullopt;
+        }
+
+        uint16_t chunk{ LoadBe16(fci.data() + offset) };
+        offset += sizeof(uint16_t);
+
+        if ((chunk & 0x8000) == 0)
+        {
+            auto symbol{ static_cast<uint8_t>((chunk >> 13) & 0x3) };
+            size_t run{ std::min<size_t>(chunk & s_maxRunLength, count - i) };
+            if (run == 0)
+            {
+                return std::nullopt;
+            }
+
+            std::fill_n(arrivalsUs.begin() + static_cast<ptrdiff_t>(i), run, symbol);
+            nDeltaBytes += run * symbol;
+            reserved |= symbol == s_reservedSymbol;
+            i += run;
+        }
+        else if ((chunk & 0x4000) == 0)
+        {
+            size_t n{ std::min(s_oneBitSymbols, count - i) };
+            for (size_t k{ 0 }; k < n; ++k)
+            {
+                auto symbol{ static_cast<uint8_t>((chunk >> (13 - k)) & 0x1) };
+                arrivalsUs[i + k] = symbol;
+                nDeltaBytes += symbol;
+            }
+            i += n;
+        }
+        else
+        {
+            size_t n{ std::min(s_twoBitSymbols, count - i) };
+            for (size_t k{ 0 }; k < n; ++k)
+            {
+                auto symbol{ static_cast<uint8_t>((chunk >> (12 - (2 * k))) & 0x3) };
+                arrivalsUs[i + k] = symbol;
+                nDeltaBytes += symbol;
+                reserved |= symbol == s_reservedSymbol;
+            }
+            i += n;
+        }
+    }
+
+    // deltas are bounds checked once here, the second pass reads without checks
+    if (reserved || offset + nDeltaBytes > fci.size())
+    {
+        return std::nullopt;
+    }
+
+    const uint8_t* delta{ fci.data() + offset };
+    int64_t arrivalUs{ static_cast<int64_t>(feedback.referenceTime) * s_refTimeUs };
+    for (auto& slot : arrivalsUs.first(count))
+    {
+        auto symbol{ static_cast<uint8_t>(slot) };
+        if (symbol == s_notReceived)
+        {
+            slot = s_twccNotReceived;
+            continue;
+        }
+
+        int64_t ticks{ symbol == s_smallDelta ? delta[0] : static_cast<int16_t>(LoadBe16(delta)) };
+        arrivalUs += ticks * s_deltaUs;
+        slot = arrivalUs;
+        delta += symbol;
+    }
+
+    return feedback;
+}
+
+std::optional<RtcpTwccFeedback> ParseTwcc(const RtcpRtpFeedbackView& view, std::span<int64_t> arrivalsUs)
+{
+    if (view.Fmt() != RtcpRtpFeedbackFmt::TransportCc)
+    {
+        return std::nullopt;
+    }
+
+    return ParseTwcc(view.fci, arrivalsUs);
+}
+
+RtcpTwccBuilder::RtcpTwccBuilder(size_t capacity) :
+    m_arrivalsUs(std::bit_ceil(std::clamp<size_t>(capacity, 1, 0x8000)), s_twccNotReceived),
+    m_symbols(m_arrivalsUs.size()),
+    m_mask{ m_arrivalsUs.size() - 1 }
+{
+}
+
+bool RtcpTwccBuilder::OnPacket(uint16_t transportSeq, Clock::time_point arrival)
+{
+    if (!m_started)
+    {
+        m_started = true;
+        m_epoch = arrival;
+        m_baseSeq = transportSeq;
+        m_nextSeq = transportSeq;
+    }
+
+    // signed distance handles the 16-bit wraparound
+    auto offset{ static_cast<int16_t>(static_cast<uint16_t>(transportSeq - m_baseSeq)) };
+    if (offset < 0 || static_cast<size_t>(offset) >= m_arrivalsUs.size())
+    {
+        return false;
+    }
+
+    auto& slot{ Slot(transportSeq) };
+    if (slot == s_twccNotReceived)
+    {
+        auto sinceEpoch{ std::chrono::duration_cast<std::chrono::microseconds>(arrival - m_epoch).count() };
+        slot = std::max<int64_t>(sinceEpoch, 0);
+    }
+
+    if (static_cast<int16_t>(static_cast<uint16_t>(transportSeq - m_nextSeq)) >= 0)
+    {
+        m_nextSeq = static_cast<uint16_t>(transportSeq + 1);
+    }
+
+    return true;
+}
+
+bool RtcpTwccBuilder::Build(RtcpWriter& writer, uint32_t senderSsrc, uint32_t mediaSsrc)
+{
+    size_t count{ Pending() };
+    if (count == 0)
+    {
+        return false;
+    }
+
+    // the window always starts at a hole or at a received packet, and ends at a received one
+    int64_t firstArrivalUs{ 0 };
+    for (size_t i{ 0 }; i < count; ++i)
+    {
+        if (auto arrivalUs{ Slot(static_cast<uint16_t>(m_baseSeq + i)) }; arrivalUs != s_twccNotReceived)
+        {
+            firstArrivalUs = arrivalUs;
+            break;
+        }
+    }
+
+    int64_t referenceTime{ firstArrivalUs / s_refTimeUs };
+    int64_t prevTicks{ referenceTime * s_deltaTicksPerRef };
+    size_t nDeltaBytes{ 0 };
+    for (size_t i{ 0 }; i < count; ++i)
+    {
+        int64_t arrivalUs{ Slot(static_cast<uint16_t>(m_baseSeq + i)) };
+        uint8_t symbol{ s_notReceived };
+        if (arrivalUs != s_twccNotReceived)
+        {
+            // quantize the arrival itself rather than the delta, so rounding does not drift
+            int64_t ticks{ arrivalUs / s_deltaUs };
+            int64_t delta{ ticks - prevTicks };
+            if (delta >= 0 && delta <= UINT8_MAX)
+            {
+                symbol = s_smallDelta;
+            }
+            else if (delta >= INT16_MIN && delta <= INT16_MAX)
+            {
+                symbol = s_largeDelta;
+            }
+            else
+            {
+                count = i;
+                break;
+            }
+            prevTicks = ticks;
+        }
+
+        m_symbols[i] = symbol;
+        nDeltaBytes += symbol;
+    }
+
+    auto symbols{ std::span<const uint8_t>{ m_symbols }.first(count) };
+    size_t chunksSize{ EncodeChunks(symbols, nullptr) * sizeof(uint16_t) };
+    size_t fciSize{ PadTo32(s_fixedFciSize + chunksSize + nDeltaBytes) };
+
+    auto fci{
+        writer.AppendFeedback(RtcpType::RtpFeedback, RtcpRtpFeedbackFmt::TransportCc, senderSsrc, mediaSsrc, fciSize)
+    };
+    if (fci.empty())
+    {
+        return false;
+    }
+
+    StoreBe16(fci.data(), m_baseSeq);
+    StoreBe16(fci.data() + 2, static_cast<uint16_t>(count));
+    StoreBe24(fci.data() + 4, static_cast<uint32_t>(referenceTime) & 0xFFFFFF);
+    fci[7] = m_fbPktCount++;
+    EncodeChunks(symbols, fci.data() + s_fixedFciSize);
+
+    uint8_t* delta{ fci.data() + s_fixedFciSize + chunksSize };
+    prevTicks = referenceTime * s_deltaTicksPerRef;
+    for (size_t i{ 0 }; i < count; ++i)
+    {
+        auto& slot{ Slot(static_cast<uint16_t>(m_baseSeq + i)) };
+        if (m_symbols[i] != s_notReceived)
+        {
+            int64_t ticks{ slot / s_deltaUs };
+            if (m_symbols[i] == s_smallDelta)
+            {
+                *delta = static_cast<uint8_t>(ticks - prevTicks);
+            }
+            else
+            {
+                StoreBe16(delta, static_cast<uint16_t>(static_cast<int16_t>(ticks - prevTicks)));
+            }
+            delta += m_symbols[i];
+            prevTicks = ticks;
+        }
+
+        // reported, free the slot for the sequence number capacity ahead
+        slot = s_twccNotReceived;
+    }
+    std::memset(delta, 0, static_cast<size_t>(fci.data() + fci.size() - delta));
+
+    m_baseSeq = static_cast<uint16_t>(m_baseSeq + count);
+    return true;
+}
+
+} // namespace rtp
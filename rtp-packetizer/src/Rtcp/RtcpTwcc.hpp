@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtcp/RtcpWriter.hpp"
+
+namespace rtp
+{
+
+/**
+Transport-wide congestion control feedback FCI (draft-holmer-rmcat-transport-wide-cc-extensions-01, RTPFB FMT=15)
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|      base sequence number     |      packet status count      |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                 reference time                | fb pkt. count |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|          packet chunk         |         packet chunk          |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+.                                                               .
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|         packet chunk          |  recv delta   |  recv delta   |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+.                                                               .
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+Reference time is a signed 24-bit count of 64 ms. Receive deltas are in 250 us: one octet for a small delta
+(0 to 63.75 ms), two signed octets for a large or negative one.
+*/
+
+// Arrival time of a packet the feedback reports as lost
+constexpr int64_t s_twccNotReceived{ std::numeric_limits<int64_t>::min() };
+
+struct RtcpTwccFeedback
+{
+    uint16_t baseSeq;
+    uint16_t statusCount;
+    // in 64 ms units, sign extended
+    int32_t referenceTime;
+    uint8_t fbPktCount;
+};
+
+// Decodes a TWCC FCI. arrivalsUs[i] receives the arrival time of transport sequence number baseSeq + i in
+// microseconds on the remote receiver's clock, or s_twccNotReceived. Nothing is allocated.
+// Returns std::nullopt if the FCI is malformed or arrivalsUs holds fewer than statusCount entries.
+std::optional<RtcpTwccFeedback> ParseTwcc(std::span<const uint8_t> fci, std::span<int64_t> arrivalsUs);
+
+// Same, for an RTPFB packet. std::nullopt if it is not transport-cc feedback.
+std::optional<RtcpTwccFeedback> ParseTwcc(const RtcpRtpFeedbackView& view, std::span<int64_t> arrivalsUs);
+
+/**
+Receiver side of transport-cc: records arrival times by transport-wide sequence number and turns them into feedback.
+
+Arrivals live in a fixed ring of capacity slots indexed by sequence number, so recording never allocates. Each Build
+reports everything from the first sequence number not yet reported up to the highest one received, then moves on.
+*/
+
+class RtcpTwccBuilder
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // capacity is rounded up to a power of two, at most half the sequence number space
+    explicit RtcpTwccBuilder(size_t capacity = 4096);
+
+    // false for a packet that was already reported, or that is capacity or more ahead of the next feedback
+    bool OnPacket(uint16_t transportSeq, Clock::time_point arrival);
+
+    // Appends one feedback packet to writer. Returns false if there is nothing to report or it does not fit.
+    // If consecutive arrivals are too far apart for one delta (about 8 s), the feedback stops short of the late one.
+    bool Build(RtcpWriter& writer, uint32_t senderSsrc, uint32_t mediaSsrc);
+
+    // Sequence numbers the next Build would report
+    size_t Pending() const { return m_started ? static_cast<uint16_t>(m_nextSeq - m_baseSeq) : 0; }
+
+private:
+    int64_t& Slot(uint16_t seq) { return m_arrivalsUs[seq & m_mask]; }
+
+    std::vector<int64_t> m_arrivalsUs;
+    std::vector<uint8_t> m_symbols;
+    size_t m_mask;
+    Clock::time_point m_epoch{};
+    uint16_t m_baseSeq{ 0 };
+    // one past the highest sequence number received
+    uint16_t m_nextSeq{ 0 };
+    uint8_t m_fbPktCount{ 0 };
+    bool m_started{ false };
+};
+
+} // namespace rtp
@@ -0,0 +1,462 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include "Rtcp/RtcpWriter.hpp"
+#include "Common/ByteOrder.hpp"
+#include "Rtcp/RtcpApp.hpp"
+#include "Rtcp/RtcpBye.hpp"
+#include "Rtcp/RtcpFeedback.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpNackSet.hpp"
+#include "Rtcp/RtcpPackets.hpp"
+#include "Rtcp/RtcpReceiverRr.hpp"
+#include "Rtcp/RtcpSdes.hpp"
+#include "Rtcp/RtcpSenderRr.hpp"
+#include "Rtcp/RtcpXr.hpp"
+
+namespace rtp
+{
+
+namespace
+{
+
+constexpr size_t s_maxCount{ 31 };
+
+constexpr size_t PadTo32(size_t size) { return (size + 3) & ~size_t{ 3 }; }
+
+struct SdesItemText
+{
+    std::string_view operator()(const RtcpSdesVariantCname& item) const { return item.cname; }
+
+    std::string_view operator()(const RtcpSdesVariantUsername& item) const { return item.username; }
+
+    std::string_view operator()(const RtcpSdesVariantEmail& item) const { return item.email; }
+
+    std::string_view operator()(const RtcpSdesVariantPhone& item) const { return item.phone; }
+
+    std::string_view operator()(const RtcpSdesVariantLoc& item) const { return item.loc; }
+
+    std::string_view operator()(const RtcpSdesVariantTool& item) const { return item.tool; }
+
+    std::string_view operator()(const RtcpSdesVariantNote& item) const { return item.note; }
+
+    std::string_view operator()(const RtcpSdesVariantPriv& item) const { return item.valStr; }
+};
+
+// Item size on the wire including its type and length octets, 0 if it cannot be encoded
+size_t SdesItemSize(const RtcpSdesVariant& item)
+{
+    size_t textSize{ std::visit(SdesItemText{}, item).size() };
+    if (const auto* priv{ std::get_if<RtcpSdesVariantPriv>(&item) })
+    {
+        // prefix length octet and prefix string
+        textSize += 1 + priv->prefixStr.size();
+    }
+
+    return textSize > 255 ? 0 : textSize + 2;
+}
+
+// Chunk size on the wire: SSRC, items, at least one null octet, padded to 32 bits. 0 if it cannot be encoded.
+size_t SdesChunkSize(const RtcpSdesChunk& chunk)
+{
+    size_t size{ sizeof(uint32_t) };
+    for (const auto& item : chunk.sdeItems)
+    {
+        size_t itemSize{ SdesItemSize(item) };
+        if (itemSize == 0)
+        {
+            return 0;
+        }
+        size += itemSize;
+    }
+
+    return PadTo32(size + 1);
+}
+
+// Writes an XR block header for a block of blockSize bytes (a multiple of 4), returns the position after it
+uint8_t* WriteXrBlockHeader(uint8_t* dst, uint8_t blockType, uint8_t typeSpecific, size_t blockSize)
+{
+    dst[0] = blockType;
+    dst[1] = typeSpecific;
+    // rfc3611#section-3, 32-bit words minus one
+    StoreBe16(dst + 2, static_cast<uint16_t>((blockSize / 4) - 1));
+    return dst + sizeof(RtcpXrBlockHeader);
+}
+
+} // namespace
+
+void WriteReportBlock(uint8_t* dst, const RtcpReportBlock& block)
+{
+    StoreBe32(dst, block.ssrc);
+    dst[4] = block.fractionLost;
+    StoreBe24(dst + 5, block.cumNumPktsLost);
+    StoreBe32(dst + 8, block.extHighestSeqNumRx);
+    StoreBe32(dst + 12, block.intervalJitter);
+    StoreBe32(dst + 16, block.lastSr);
+    StoreBe32(dst + 20, block.delayLastSr);
+}
+
+uint8_t* RtcpWriter::BeginPkt(uint8_t pktType, uint8_t count, size_t pktSize)
+{
+    uint8_t* dst{ m_buffer.data() + m_size };
+
+    // V=2, P=0, count
+    dst[0] = static_cast<uint8_t>(0x80 | (count & 0x1F));
+    dst[1] = pktType;
+    // rfc3550#section-6.4.1, 32-bit words minus one
+    StoreBe16(dst + 2, static_cast<uint16_t>((pktSize / 4) - 1));
+
+    m_size += pktSize;
+    return dst;
+}
+
+bool RtcpWriter::WriteReport(
+    RtcpType pktType,
+    uint32_t ssrc,
+    const RtcpSenderReportHeader* senderInfo,
+    std::span<const RtcpReportBlock> rrBlocks
+)
+{
+    size_t headerSize{ senderInfo != nullptr ? sizeof(RtcpSenderReportHeader) : sizeof(RtcpReceiverReportHeader) };
+    size_t pktSize{ headerSize + (rrBlocks.size() * sizeof(RtcpReportBlock)) };
+    if (rrBlocks.size() > s_maxCount || pktSize > Remaining())
+    {
+        return false;
+    }
+
+    uint8_t* dst{ BeginPkt(pktType, static_cast<uint8_t>(rrBlocks.size()), pktSize) };
+    StoreBe32(dst + 4, ssrc);
+    if (senderInfo != nullptr)
+    {
+        StoreBe32(dst + 8, senderInfo->ntpTimestampMsb);
+        StoreBe32(dst + 12, senderInfo->ntpTimestampLsb);
+        StoreBe32(dst + 16, senderInfo->rtpTimestamp);
+        StoreBe32(dst + 20, senderInfo->senderPktCnt);
+        StoreBe32(dst + 24, senderInfo->senderOctetCnt);
+    }
+
+    dst += headerSize;
+    for (const auto& block : rrBlocks)
+    {
+        WriteReportBlock(dst, block);
+        dst += sizeof(RtcpReportBlock);
+    }
+
+    return true;
+}
+
+bool RtcpWriter::WriteSenderReport(const RtcpSenderReportHeader& header, std::span<const RtcpReportBlock> rrBlocks)
+{
+    return WriteReport(RtcpType::SenderRR, header.ssrc, &header, rrBlocks);
+}
+
+bool RtcpWriter::WriteReceiverReport(const RtcpReceiverReportHeader& header, std::span<const RtcpReportBlock> rrBlocks)
+{
+    return WriteReport(RtcpType::ReceiverRR, header.ssrc, nullptr, rrBlocks);
+}
+
+bool RtcpWriter::WriteSdes(std::span<const RtcpSdesChunk> chunks)
+{
+    if (chunks.size() > s_maxCount)
+    {
+        return false;
+    }
+
+    size_t pktSize{ sizeof(RtcpSdesHeader) };
+    for (const auto& chunk : chunks)
+    {
+        size_t chunkSize{ SdesChunkSize(chunk) };
+        if (chunkSize == 0)
+        {
+            return false;
+        }
+        pktSize += chunkSize;
+    }
+
+    if (pktSize > Remaining() || ((pktSize / 4) - 1) > UINT16_MAX)
+    {
+        return false;
+    }
+
+    uint8_t* dst{ BeginPkt(RtcpType::Sdes, static_cast<uint8_t>(chunks.size()), pktSize) };
+    dst += sizeof(RtcpSdesHeader);
+
+    for (const auto& chunk : chunks)
+    {
+        uint8_t* chunkStart{ dst };
+        StoreBe32(dst, chunk.ssrc);
+        dst += sizeof(uint32_t);
+
+        for (const auto& item : chunk.sdeItems)
+        {
+            auto text{ std::visit(SdesItemText{}, item) };
+            dst[0] = std::visit([](const auto& typedItem) -> uint8_t { return typedItem.s_type; }, item);
+            dst[1] = static_cast<uint8_t>(SdesItemSize(item) - 2);
+            dst += 2;
+
+            if (const auto* priv{ std::get_if<RtcpSdesVariantPriv>(&item) })
+            {
+                *dst++ = static_cast<uint8_t>(priv->prefixStr.size());
+                std::memcpy(dst, priv->prefixStr.data(), priv->prefixStr.size());
+                dst += priv->prefixStr.size();
+            }
+
+            std::memcpy(dst, text.data(), text.size());
+            dst += text.size();
+        }
+
+        // null item terminator plus padding to the next 32-bit boundary
+        size_t chunkSize{ SdesChunkSize(chunk) };
+        size_t written{ static_cast<size_t>(dst - chunkStart) };
+        std::memset(dst, 0, chunkSize - written);
+        dst += chunkSize - written;
+    }
+
+    return true;
+}
+
+bool RtcpWriter::WriteBye(std::span<const uint32_t> ssrcs, std::string_view reason)
+{
+    if (ssrcs.size() > s_maxCount || reason.size() > 255)
+    {
+        return false;
+    }
+
+    size_t reasonSize{ reason.empty() ? 0 : PadTo32(1 + reason.size()) };
+    size_t pktSize{ sizeof(RtcpHeader) + (ssrcs.size() * sizeof(uint32_t)) + reasonSize };
+    if (pktSize > Remaining())
+    {
+        return false;
+    }
+
+    uint8_t* dst{ BeginPkt(RtcpType::Bye, static_cast<uint8_t>(ssrcs.size()), pktSize) };
+    dst += sizeof(RtcpHeader);
+
+    for (auto ssrc : ssrcs)
+    {
+        StoreBe32(dst, ssrc);
+        dst += sizeof(uint32_t);
+    }
+
+    if (!reason.empty())
+    {
+        dst[0] = static_cast<uint8_t>(reason.size());
+        std::memcpy(dst + 1, reason.data(), reason.size());
+        std::memset(dst + 1 + reason.size(), 0, reasonSize - 1 - reason.size());
+    }
+
+    return true;
+}
+
+bool RtcpWriter::WriteApp(const RtcpAppHeader& header, std::span<const uint8_t> data)
+{
+    // application-dependent data must be a multiple of 32 bits, pad with zeros
+    size_t dataSize{ PadTo32(data.size()) };
+    size_t pktSize{ sizeof(RtcpAppHeader) + dataSize };
+    if (pktSize > Remaining() || ((pktSize / 4) - 1) > UINT16_MAX)
+    {
+        return false;
+    }
+
+    uint8_t* dst{ BeginPkt(RtcpType::App, header.cmnHdr.receptionCount, pktSize) };
+    StoreBe32(dst + 4, header.ssrc);
+    std::memcpy(dst + 8, header.name.data(), header.name.size());
+
+    dst += sizeof(RtcpAppHeader);
+    if (!data.empty())
+    {
+        std::memcpy(dst, data.data(), data.size());
+    }
+    std::memset(dst + data.size(), 0, dataSize - data.size());
+
+    return true;
+}
+
+uint8_t* RtcpWriter::BeginFeedback(
+    RtcpType pktType,
+    uint8_t fmt,
+    uint32_t senderSsrc,
+    uint32_t mediaSsrc,
+    size_t fciSize
+)
+{
+    size_t pktSize{ sizeof(RtcpFeedbackHeader) + fciSize };
+    if (pktSize > Remaining() || ((pktSize / 4) - 1) > UINT16_MAX)
+    {
+        return nullptr;
+    }
+
+    uint8_t* dst{ BeginPkt(pktType, fmt, pktSize) };
+    StoreBe32(dst + 4, senderSsrc);
+    StoreBe32(dst + 8, mediaSsrc);
+    return dst + sizeof(RtcpFeedbackHeader);
+}
+
+std::span<uint8_t> RtcpWriter::AppendFeedback(
+    RtcpType pktType,
+    uint8_t fmt,
+    uint32_t senderSsrc,
+    uint32_t mediaSsrc,
+    size_t fciSize
+)
+{
+    if (fciSize % 4 != 0)
+    {
+        return {};
+    }
+
+    uint8_t* dst{ BeginFeedback(pktType, fmt, senderSsrc, mediaSsrc, fciSize) };
+    return dst != nullptr ? std::span<uint8_t>{ dst, fciSize } : std::span<uint8_t>{};
+}
+
+bool RtcpWriter::WriteNack(uint32_t senderSsrc, uint32_t mediaSsrc, const RtcpNackSet& lost)
+{
+    size_t nItems{ lost.ItemCount() };
+    if (nItems == 0)
+    {
+        return false;
+    }
+
+    uint8_t* dst{ BeginFeedback(
+        RtcpType::RtpFeedback, RtcpRtpFeedbackFmt::GenericNack, senderSsrc, mediaSsrc, nItems * sizeof(RtcpNackItem)
+    ) };
+    if (dst == nullptr)
+    {
+        return false;
+    }
+
+    lost.ForEachItem(
+        [&dst](uint16_t pid, uint16_t blp)
+        {
+            StoreBe16(dst, pid);
+            StoreBe16(dst + 2, blp);
+            dst += sizeof(RtcpNackItem);
+        }
+    );
+
+    return true;
+}
+
+bool RtcpWriter::WritePli(uint32_t senderSsrc, uint32_t mediaSsrc)
+{
+    return BeginFeedback(RtcpType::PayloadFeedback, RtcpPayloadFeedbackFmt::Pli, senderSsrc, mediaSsrc, 0) != nullptr;
+}
+
+bool RtcpWriter::WriteFir(uint32_t senderSsrc, std::span<const RtcpFirItem> items)
+{
+    if (items.empty())
+    {
+        return false;
+    }
+
+    // rfc5104#section-4.3.1.2, media source SSRC is not used and set to 0
+    uint8_t* dst{ BeginFeedback(
+        RtcpType::PayloadFeedback, RtcpPayloadFeedbackFmt::Fir, senderSsrc, 0, items.size() * sizeof(RtcpFirItem)
+    ) };
+    if (dst == nullptr)
+    {
+        return false;
+    }
+
+    for (const auto& item : items)
+    {
+        StoreBe32(dst, item.ssrc);
+        dst[4] = item.seqNr;
+        std::memset(dst + 5, 0, item.reserved.size());
+        dst += sizeof(RtcpFirItem);
+    }
+
+    return true;
+}
+
+bool RtcpWriter::WriteXr(uint32_t ssrc, const RtcpXrReportBlocks& blocks)
+{
+    size_t dlrrSize{ blocks.dlrr.empty() ? 0 : sizeof(RtcpXrBlockHeader) + blocks.dlrr.size_bytes() };
+    size_t pktSize{ sizeof(RtcpXrHeader) + (blocks.rrtr != nullptr ? sizeof(RtcpXrRrtrBlock) : 0) + dlrrSize +
+                    blocks.statSummaries.size_bytes() + blocks.voipMetrics.size_bytes() };
+    if (pktSize > Remaining() || ((pktSize / 4) - 1) > UINT16_MAX || dlrrSize / 4 > UINT16_MAX)
+    {
+        return false;
+    }
+
+    uint8_t* dst{ BeginPkt(RtcpType::ExtendedReport, 0, pktSize) };
+    StoreBe32(dst + 4, ssrc);
+    dst += sizeof(RtcpXrHeader);
+
+    if (blocks.rrtr != nullptr)
+    {
+        dst = WriteXrBlockHeader(dst, RtcpXrBlockType::Rrtr, 0, sizeof(RtcpXrRrtrBlock));
+        StoreBe32(dst, blocks.rrtr->ntpTimestampMsb);
+        StoreBe32(dst + 4, blocks.rrtr->ntpTimestampLsb);
+        dst += 8;
+    }
+
+    if (!blocks.dlrr.empty())
+    {
+        dst = WriteXrBlockHeader(dst, RtcpXrBlockType::Dlrr, 0, dlrrSize);
+        for (const auto& item : blocks.dlrr)
+        {
+            StoreBe32(dst, item.ssrc);
+            StoreBe32(dst + 4, item.lastRr);
+            StoreBe32(dst + 8, item.delayLastRr);
+            dst += sizeof(RtcpXrDlrrItem);
+        }
+    }
+
+    for (const auto& block : blocks.statSummaries)
+    {
+        dst = WriteXrBlockHeader(
+            dst, RtcpXrBlockType::StatSummary, block.blockHdr.typeSpecific, sizeof(RtcpXrStatSummaryBlock)
+        );
+        StoreBe32(dst, block.ssrc);
+        StoreBe16(dst + 4, block.beginSeq);
+        StoreBe16(dst + 6, block.endSeq);
+        StoreBe32(dst + 8, block.lostPackets);
+        StoreBe32(dst + 12, block.dupPackets);
+        StoreBe32(dst + 16, block.minJitter);
+        StoreBe32(dst + 20, block.maxJitter);
+        StoreBe32(dst + 24, block.meanJitter);
+        StoreBe32(dst + 28, block.devJitter);
+        dst[32] = block.minTtlOrHl;
+        dst[33] = block.maxTtlOrHl;
+        dst[34] = block.meanTtlOrHl;
+        dst[35] = block.devTtlOrHl;
+        dst += sizeof(RtcpXrStatSummaryBlock) - sizeof(RtcpXrBlockHeader);
+    }
+
+    for (const auto& block : blocks.voipMetrics)
+    {
+        dst = WriteXrBlockHeader(dst, RtcpXrBlockType::VoipMetrics, 0, sizeof(RtcpXrVoipMetricsBlock));
+        StoreBe32(dst, block.ssrc);
+        dst[4] = block.lossRate;
+        dst[5] = block.discardRate;
+        dst[6] = block.burstDensity;
+        dst[7] = block.gapDensity;
+        StoreBe16(dst + 8, block.burstDuration);
+        StoreBe16(dst + 10, block.gapDuration);
+        StoreBe16(dst + 12, block.roundTripDelay);
+        StoreBe16(dst + 14, block.endSystemDelay);
+        dst[16] = block.signalLevel;
+        dst[17] = block.noiseLevel;
+        dst[18] = block.rerl;
+        dst[19] = block.gmin;
+        dst[20] = block.rFactor;
+        dst[21] = block.extRFactor;
+        dst[22] = block.mosLq;
+        dst[23] = block.mosCq;
+        dst[24] = block.rxConfig;
+        dst[25] = 0;
+        StoreBe16(dst + 26, block.jbNominal);
+        StoreBe16(dst + 28, block.jbMaximum);
+        StoreBe16(dst + 30, block.jbAbsMax);
+        dst += sizeof(RtcpXrVoipMetricsBlock) - sizeof(RtcpXrBlockHeader);
+    }
+
+    return true;
+}
+
+} // namespace rtp
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "Rtcp/RtcpApp.hpp"
+#include "Rtcp/RtcpFeedback.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpNackSet.hpp"
+#include "Rtcp/RtcpPackets.hpp"
+#include "Rtcp/RtcpReceiverRr.hpp"
+#include "Rtcp/RtcpSenderRr.hpp"
+#include "Rtcp/RtcpXr.hpp"
+
+namespace rtp
+{
+
+// Report blocks of one XR packet, in host byte order. Empty parts are left out, so is an RRTR block without rrtr.
+// Block headers are derived from the content, except the stat summary flags taken from blockHdr.typeSpecific.
+struct RtcpXrReportBlocks
+{
+    const RtcpXrRrtrBlock* rrtr{ nullptr };
+    std::span<const RtcpXrDlrrItem> dlrr{};
+    std::span<const RtcpXrStatSummaryBlock> statSummaries{};
+    std::span<const RtcpXrVoipMetricsBlock> voipMetrics{};
+};
+
+/**
+Serializes RTCP packets straight into a caller-supplied send buffer.
+
+Successive writes append sub-packets, so one writer builds a compound packet in a single pass. Field values in the
+packet structs are taken in host byte order and written in network byte order. The common header (version, count,
+length) is always derived from the content, whatever the input header holds.
+
+Every write either appends a complete sub-packet and returns true, or leaves the buffer untouched and returns false
+when the sub-packet does not fit or cannot be encoded (e.g. more than 31 report blocks or SDES chunks).
+*/
+
+class RtcpWriter
+{
+public:
+    explicit RtcpWriter(std::span<uint8_t> buffer) : m_buffer{ buffer } {}
+
+    bool WriteSenderReport(const RtcpSenderReportPkt& pkt) { return WriteSenderReport(pkt.header, pkt.rrBlocks); }
+
+    bool WriteSenderReport(const RtcpSenderReportHeader& header, std::span<const RtcpReportBlock> rrBlocks);
+
+    bool WriteReceiverReport(const RtcpReceiverReportPkt& pkt) { return WriteReceiverReport(pkt.header, pkt.rrBlocks); }
+
+    bool WriteReceiverReport(const RtcpReceiverReportHeader& header, std::span<const RtcpReportBlock> rrBlocks);
+
+    bool WriteSdes(const RtcpSdesPkt& pkt) { return WriteSdes(pkt.chunks); }
+
+    bool WriteSdes(std::span<const RtcpSdesChunk> chunks);
+
+    bool WriteBye(const RtcpByePkt& pkt)
+    {
+        const uint32_t ssrc{ pkt.header.ssrc };
+        return WriteBye({ &ssrc, 1 }, {});
+    }
+
+    bool WriteBye(std::span<const uint32_t> ssrcs, std::string_view reason);
+
+    bool WriteApp(const RtcpAppPkt& pkt) { return WriteApp(pkt.header, pkt.data); }
+
+    // The subtype is taken from header.cmnHdr.receptionCount
+    bool WriteApp(const RtcpAppHeader& header, std::span<const uint8_t> data);
+
+    bool WriteNack(const RtcpNackPkt& pkt) { return WriteNack(pkt.header.senderSsrc, pkt.header.mediaSsrc, pkt.lost); }
+
+    // Generic NACK with the fewest PID/BLP entries covering lost, which must not be empty
+    bool WriteNack(uint32_t senderSsrc, uint32_t mediaSsrc, const RtcpNackSet& lost);
+
+    bool WritePli(uint32_t senderSsrc, uint32_t mediaSsrc);
+
+    // FIR entries are taken in host byte order, at least one is required
+    bool WriteFir(uint32_t senderSsrc, std::span<const RtcpFirItem> items);
+
+    bool WriteXr(uint32_t ssrc, const RtcpXrReportBlocks& blocks);
+
+    // Appends an RTPFB/PSFB packet with fciSize bytes of FCI (a multiple of 4) and returns the FCI for the caller to
+    // fill, or an empty span if it does not fit. For formats without a dedicated writer, e.g. RtcpTwccBuilder.
+    std::span<uint8_t> AppendFeedback(
+        RtcpType pktType,
+        uint8_t fmt,
+        uint32_t senderSsrc,
+        uint32_t mediaSsrc,
+        size_t fciSize
+    );
+
+    // Bytes written so far, the compound packet
+    std::span<const uint8_t> Written() const { return m_buffer.first(m_size); }
+
+    size_t Size() const { return m_size; }
+
+    size_t Remaining() const { return m_buffer.size() - m_size; }
+
+    void Reset() { m_size = 0; }
+
+private:
+    // Writes the common header of a sub-packet of pktSize bytes (a multiple of 4) at the current position
+    uint8_t* BeginPkt(uint8_t pktType, uint8_t count, size_t pktSize);
+
+    bool WriteReport(
+        RtcpType pktType,
+        uint32_t ssrc,
+        const RtcpSenderReportHeader* senderInfo,
+        std::span<const RtcpReportBlock> rrBlocks
+    );
+
+    // Common header and both SSRCs of an RTPFB/PSFB packet with fciSize bytes of FCI, nullptr if it does not fit
+    uint8_t* BeginFeedback(RtcpType pktType, uint8_t fmt, uint32_t senderSsrc, uint32_t mediaSsrc, size_t fciSize);
+
+    std::span<uint8_t> m_buffer;
+    size_t m_size{ 0 };
+};
+
+// Writes one report block, host to network byte order
+void WriteReportBlock(uint8_t* dst, const RtcpReportBlock& block);
+
+} // namespace rtp
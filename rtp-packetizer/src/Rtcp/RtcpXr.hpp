@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstdint>
+#include <endian.h>
+#include "Rtcp/RtcpHeader.hpp"
+
+namespace rtp
+{
+
+// rfc3611#section-4
+enum RtcpXrBlockType : uint8_t
+{
+    LossRle = 1,
+    DuplicateRle = 2,
+    PktReceiptTimes = 3,
+    Rrtr = 4,
+    Dlrr = 5,
+    StatSummary = 6,
+    VoipMetrics = 7,
+};
+
+/**
+XR: Extended Report RTCP Packet
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|V=2|P|reserved |   PT=XR=207   |             length            |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                              SSRC                             |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+:                         report blocks                         :
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+struct [[gnu::packed]] RtcpXrHeader
+{
+    RtcpHeader cmnHdr;
+    uint32_t ssrc;
+};
+
+/**
+XR Report Block Header, length is in 32-bit words minus one like the RTCP common header
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|      BT       | type-specific |         block length          |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+struct [[gnu::packed]] RtcpXrBlockHeader
+{
+    uint8_t blockType;
+    uint8_t typeSpecific;
+    uint16_t length;
+};
+
+/**
+Receiver Reference Time Report Block (rfc3611#section-4.4)
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|     BT=4      |   reserved    |       block length = 2        |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|              NTP timestamp, most significant word             |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|             NTP timestamp, least significant word             |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+struct [[gnu::packed]] RtcpXrRrtrBlock
+{
+    RtcpXrBlockHeader blockHdr;
+    uint32_t ntpTimestampMsb;
+    uint32_t ntpTimestampLsb;
+};
+
+/**
+DLRR Report Block (rfc3611#section-4.5), one sub-block per receiver
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|     BT=5      |   reserved    |         block length          |
++=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+
+|                 SSRC_1 (SSRC of first receiver)               | sub-
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+ block
+|                         last RR (LRR)                         |   1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                   delay since last RR (DLRR)                  |
++=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+
+:                               ...                             :
++=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+=+
+*/
+
+struct [[gnu::packed]] RtcpXrDlrrItem
+{
+    uint32_t ssrc;
+    uint32_t lastRr;
+    uint32_t delayLastRr;
+};
+
+/**
+Statistics Summary Report Block (rfc3611#section-4.6). Type-specific flags: L=0x80, D=0x40, J=0x20, ToH=0x18.
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|     BT=6      |L|D|J|ToH|rsvd.|       block length = 9        |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                        SSRC of source                         |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|          begin_seq            |             end_seq           |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                        lost_packets                           |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                        dup_packets                            |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                         min_jitter                            |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                         max_jitter                            |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                         mean_jitter                           |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                         dev_jitter                            |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+| min_ttl_or_hl | max_ttl_or_hl |mean_ttl_or_hl | dev_ttl_or_hl |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+struct [[gnu::packed]] RtcpXrStatSummaryBlock
+{
+    RtcpXrBlockHeader blockHdr;
+    uint32_t ssrc;
+    uint16_t beginSeq;
+    uint16_t endSeq;
+    uint32_t lostPackets;
+    uint32_t dupPackets;
+    uint32_t minJitter;
+    uint32_t maxJitter;
+    uint32_t meanJitter;
+    uint32_t devJitter;
+    uint8_t minTtlOrHl;
+    uint8_t maxTtlOrHl;
+    uint8_t meanTtlOrHl;
+    uint8_t devTtlOrHl;
+};
+
+/**
+VoIP Metrics Report Block (rfc3611#section-4.7)
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|     BT=7      |   reserved    |       block length = 8        |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                        SSRC of source                         |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|   loss rate   | discard rate  | burst density |  gap density  |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|       burst duration          |         gap duration          |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|     round trip delay          |       end system delay        |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+| signal level  |  noise level  |     RERL      |     Gmin      |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|   R factor    | ext. R factor |    MOS-LQ     |    MOS-CQ     |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|   RX config   |   reserved    |          JB nominal           |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|          JB maximum           |          JB abs max           |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+struct [[gnu::packed]] RtcpXrVoipMetricsBlock
+{
+    RtcpXrBlockHeader blockHdr;
+    uint32_t ssrc;
+    uint8_t lossRate;
+    uint8_t discardRate;
+    uint8_t burstDensity;
+    uint8_t gapDensity;
+    uint16_t burstDuration;
+    uint16_t gapDuration;
+    uint16_t roundTripDelay;
+    uint16_t endSystemDelay;
+    uint8_t signalLevel;
+    uint8_t noiseLevel;
+    uint8_t rerl;
+    uint8_t gmin;
+    uint8_t rFactor;
+    uint8_t extRFactor;
+    uint8_t mosLq;
+    uint8_t mosCq;
+    uint8_t rxConfig;
+    uint8_t reserved;
+    uint16_t jbNominal;
+    uint16_t jbMaximum;
+    uint16_t jbAbsMax;
+};
+
+// rfc3611#section-4.5, round trip time in 1/65536 s from a DLRR sub-block in host byte order, given the middle 32 bits
+// of the NTP time it arrived at. 0 when the sub-block carries no RRTR yet.
+inline uint32_t RtcpXrRoundTrip(uint32_t arrivalNtpMid, const RtcpXrDlrrItem& item)
+{
+    if (item.lastRr == 0)
+    {
+        return 0;
+    }
+
+    return arrivalNtpMid - item.lastRr - item.delayLastRr;
+}
+
+} // namespace rtp
@@ -0,0 +1,457 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <endian.h>
+#include <span>
+#include <sys/uio.h>
+#include "Rtp/H264Payload.hpp"
+#include "Rtp/RtpHeader.hpp"
+#include "Rtp/RtpPacketView.hpp"
+#include "Rtp/RtpPacketizer.hpp"
+
+namespace rtp
+{
+
+namespace
+{
+
+constexpr std::array<uint8_t, 4> s_startCode{ 0x00, 0x00, 0x00, 0x01 };
+
+constexpr uint8_t NalType(uint8_t nalHeader) { return nalHeader & 0x1F; }
+
+// F and NRI bits
+constexpr uint8_t NalFNri(uint8_t nalHeader) { return nalHeader & 0xE0; }
+
+constexpr uint8_t s_fuStartBit{ 0x80 };
+constexpr uint8_t s_fuEndBit{ 0x40 };
+
+} // namespace
+
+size_t SplitAnnexB(std::span<const uint8_t> accessUnit, std::span<std::span<const uint8_t>> nals)
+{
+    size_t nFound{ 0 };
+    size_t nalStart{ 0 };
+    bool inNal{ false };
+
+    auto emit{ [&](size_t end)
+               {
+                   // trailing zeros belong to the next 4 byte start code or are trailing_zero_8bits
+                   while (end > nalStart && accessUnit[end - 1] == 0)
+                   {
+                       --end;
+                   }
+
+                   if (end > nalStart)
+                   {
+                       if (nFound < nals.size())
+                       {
+                           nals[nFound] = accessUnit.subspan(nalStart, end - nalStart);
+                       }
+                       ++nFound;
+                   }
+               } };
+
+    size_t i{ 0 };
+    while (i + 3 <= accessUnit.size())
+    {
+        if (accessUnit[i] == 0 && accessUnit[i + 1] == 0 && accessUnit[i + 2] == 1)
+        {
+            if (inNal)
+            {
+                emit(i);
+            }
+
+            i += 3;
+            nalStart = i;
+            inNal = true;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    if (inNal)
+    {
+        emit(accessUnit.size());
+    }
+
+    return nFound;
+}
+
+H264Packetizer::H264Packetizer(const RtpPacketizerConfig& config) :
+    m_slotPool(std::bit_ceil(std::max<size_t>(config.headerPoolSize, 1))),
+    m_poolMask{ m_slotPool.size() - 1 },
+    // room for at least one byte of FU-A payload
+    m_maxPayloadSize{ std::max<size_t>(config.mtu, sizeof(RptHeader) + sizeof(H264FuAHeader) + 1) -
+                      sizeof(RptHeader) },
+    m_ssrc{ config.ssrc },
+    m_payloadType{ config.payloadType },
+    m_nextSeq{ config.initialSeq }
+{
+}
+
+size_t H264Packetizer::StapCount(std::span<const std::span<const uint8_t>> nals) const
+{
+    size_t limit{ std::min(m_maxPayloadSize, s_maxStapSize) };
+    // STAP-A NAL header
+    size_t total{ 1 };
+    size_t count{ 0 };
+    for (const auto& nal : nals)
+    {
+        if (nal.empty())
+        {
+            break;
+        }
+
+        total += sizeof(uint16_t) + nal.size();
+        if (total > limit)
+        {
+            break;
+        }
+
+        ++count;
+    }
+
+    return count;
+}
+
+size_t H264Packetizer::CountPackets(std::span<const std::span<const uint8_t>> nals) const
+{
+    size_t nPkts{ 0 };
+    size_t fuPayloadSize{ m_maxPayloadSize - sizeof(H264FuAHeader) };
+
+    size_t i{ 0 };
+    while (i < nals.size())
+    {
+        const auto& nal{ nals[i] };
+        if (nal.empty())
+        {
+            ++i;
+            continue;
+        }
+
+        if (size_t nStap{ StapCount(nals.subspan(i)) }; nStap > 1)
+        {
+            ++nPkts;
+            i += nStap;
+        }
+        else if (nal.size() <= m_maxPayloadSize)
+        {
+            ++nPkts;
+            ++i;
+        }
+        else
+        {
+            // the NAL header is carried in the FU indicator/header, not repeated in the fragments
+            nPkts += (nal.size() - 1 + fuPayloadSize - 1) / fuPayloadSize;
+            ++i;
+        }
+    }
+
+    return nPkts;
+}
+
+size_t H264Packetizer::Packetize(
+    std::span<const std::span<const uint8_t>> nals, uint32_t rtpTimestamp, std::span<RtpOutPacket> out
+)
+{
+    size_t nPkts{ CountPackets(nals) };
+    if (nPkts == 0 || nPkts > out.size() || nPkts > m_slotPool.size())
+    {
+        return 0;
+    }
+
+    size_t fuPayloadSize{ m_maxPayloadSize - sizeof(H264FuAHeader) };
+    size_t pktIdx{ 0 };
+
+    auto nextPacket{ [&](size_t prefixSize, std::span<const uint8_t> payload) -> uint8_t*
+                     {
+                         auto& slot{ NextSlot() };
+                         RptHeader header{};
+                         FillRtpHeader(header, m_payloadType, (pktIdx + 1 == nPkts), m_nextSeq++, rtpTimestamp, m_ssrc);
+                         std::memcpy(slot.bytes.data(), &header, sizeof(header));
+
+                         out[pktIdx].iov[0] = iovec{ .iov_base = slot.bytes.data(),
+                                                     .iov_len = sizeof(RptHeader) + prefixSize };
+                         // iovec is not const-correct, the payload is only ever read
+                         out[pktIdx].iov[1] = iovec{ .iov_base = const_cast<uint8_t*>(payload.data()),
+                                                     .iov_len = payload.size() };
+                         ++pktIdx;
+
+                         return slot.bytes.data() + sizeof(RptHeader);
+                     } };
+
+    size_t i{ 0 };
+    while (i < nals.size())
+    {
+        const auto& nal{ nals[i] };
+        if (nal.empty())
+        {
+            ++i;
+            continue;
+        }
+
+        if (size_t nStap{ StapCount(nals.subspan(i)) }; nStap > 1)
+        {
+            size_t stapSize{ 1 };
+            for (const auto& aggNal : nals.subspan(i, nStap))
+            {
+                stapSize += sizeof(uint16_t) + aggNal.size();
+            }
+
+            auto* prefix{ nextPacket(stapSize, {}) };
+
+            // highest F and NRI of the aggregated units, rfc6184#section-5.7.1
+            uint8_t fNri{ 0 };
+            size_t offset{ 1 };
+            for (const auto& aggNal : nals.subspan(i, nStap))
+            {
+                fNri = std::max<uint8_t>(fNri, NalFNri(aggNal[0]));
+                auto nalSize{ htobe16(static_cast<uint16_t>(aggNal.size())) };
+                std::memcpy(prefix + offset, &nalSize, sizeof(nalSize));
+                std::memcpy(prefix + offset + sizeof(nalSize), aggNal.data(), aggNal.size());
+                offset += sizeof(nalSize) + aggNal.size();
+            }
+            prefix[0] = fNri | H264NalType::StapA;
+
+            i += nStap;
+        }
+        else if (nal.size() <= m_maxPayloadSize)
+        {
+            nextPacket(0, nal);
+            ++i;
+        }
+        else
+        {
+            uint8_t nalHeader{ nal[0] };
+            auto fragments{ nal.subspan(1) };
+            while (!fragments.empty())
+            {
+                auto fragment{ fragments.first(std::min(fuPayloadSize, fragments.size())) };
+                bool first{ fragments.size() == nal.size() - 1 };
+                bool last{ fragment.size() == fragments.size() };
+
+                auto* prefix{ nextPacket(sizeof(H264FuAHeader), fragment) };
+                prefix[0] = NalFNri(nalHeader) | H264NalType::FuA;
+                prefix[1] = (first ? s_fuStartBit : 0) | (last ? s_fuEndBit : 0) | NalType(nalHeader);
+
+                fragments = fragments.subspan(fragment.size());
+            }
+            ++i;
+        }
+    }
+
+    return nPkts;
+}
+
+H264Packetizer::Slot& H264Packetizer::NextSlot()
+{
+    auto& slot{ m_slotPool[m_poolPos & m_poolMask] };
+    ++m_poolPos;
+    return slot;
+}
+
+void H264Reassembler::Reset()
+{
+    m_frameSize = 0;
+    m_fuStart = 0;
+    m_inFu = false;
+    m_frameDone = false;
+    m_damaged = false;
+    m_skipFrame = false;
+}
+
+H264PushResult H264Reassembler::Push(const RtpPacketView& pkt)
+{
+    auto seq{ be16toh(pkt.header->seq) };
+    auto ts{ be32toh(pkt.header->ts) };
+
+    bool gap{ m_haveSeq && seq != static_cast<uint16_t>(m_lastSeq + 1) };
+    m_haveSeq = true;
+    m_lastSeq = seq;
+
+    if (m_frameDone || ts != m_frameTs)
+    {
+        // a new access unit, an unfinished previous one without marker is discarded
+        Reset();
+        m_frameTs = ts;
+    }
+
+    auto res{ H264PushResult::Incomplete };
+    if (gap)
+    {
+        // the lost packets may belong to this access unit even when it starts here
+        m_damaged = true;
+        if (m_inFu)
+        {
+            DropFu();
+            res = H264PushResult::Dropped;
+        }
+    }
+
+    if (!m_skipFrame)
+    {
+        const auto& payload{ pkt.payload };
+        H264PushResult pushRes{ H264PushResult::Dropped };
+        if (!payload.empty())
+        {
+            switch (NalType(payload[0]))
+            {
+                case H264NalType::StapA:
+                {
+                    pushRes = PushStapA(payload);
+                    break;
+                }
+                case H264NalType::FuA:
+                {
+                    pushRes = PushFuA(payload);
+                    break;
+                }
+                default:
+                {
+                    // 1-23 single NAL unit, others (STAP-B, MTAP, FU-B) are not valid in packetization-mode=1
+                    if (NalType(payload[0]) >= 1 && NalType(payload[0]) <= 23)
+                    {
+                        pushRes = AppendNal(payload) ? H264PushResult::Incomplete : H264PushResult::Overflow;
+                    }
+                    break;
+                }
+            }
+        }
+
+        if (pushRes == H264PushResult::Overflow)
+        {
+            m_frameSize = 0;
+            m_inFu = false;
+            m_skipFrame = true;
+            res = pushRes;
+        }
+        else if (pushRes == H264PushResult::Dropped)
+        {
+            m_damaged = true;
+            res = pushRes;
+        }
+    }
+
+    if (pkt.header->marker != 0)
+    {
+        if (m_skipFrame)
+        {
+            // the overflowed access unit ends here, start clean with the next one
+            Reset();
+            m_frameDone = true;
+            return res == H264PushResult::Incomplete ? H264PushResult::Overflow : res;
+        }
+
+        if (m_inFu)
+        {
+            // the access unit ends inside a FU-A that never got its end fragment
+            DropFu();
+            m_damaged = true;
+        }
+
+        m_frameDone = true;
+        return m_damaged ? H264PushResult::FrameDamaged : H264PushResult::FrameComplete;
+    }
+
+    return res;
+}
+
+H264PushResult H264Reassembler::PushStapA(std::span<const uint8_t> payload)
+{
+    auto units{ payload.subspan(1) };
+    while (units.size() >= sizeof(uint16_t))
+    {
+        uint16_t nalSize{};
+        std::memcpy(&nalSize, units.data(), sizeof(nalSize));
+        nalSize = be16toh(nalSize);
+        units = units.subspan(sizeof(nalSize));
+
+        if (nalSize == 0 || nalSize > units.size())
+        {
+            return H264PushResult::Dropped;
+        }
+
+        if (!AppendNal(units.first(nalSize)))
+        {
+            return H264PushResult::Overflow;
+        }
+        units = units.subspan(nalSize);
+    }
+
+    return H264PushResult::Incomplete;
+}
+
+H264PushResult H264Reassembler::PushFuA(std::span<const uint8_t> payload)
+{
+    if (payload.size() < sizeof(H264FuAHeader) + 1)
+    {
+        return H264PushResult::Dropped;
+    }
+
+    uint8_t indicator{ payload[0] };
+    uint8_t fuHeader{ payload[1] };
+    auto fragment{ payload.subspan(sizeof(H264FuAHeader)) };
+
+    auto res{ H264PushResult::Incomplete };
+    if ((fuHeader & s_fuStartBit) != 0)
+    {
+        if (m_inFu)
+        {
+            // previous FU-A never got its end fragment
+            DropFu();
+            res = H264PushResult::Dropped;
+        }
+
+        m_fuStart = m_frameSize;
+        std::array<uint8_t, 1> nalHeader{ static_cast<uint8_t>(NalFNri(indicator) | NalType(fuHeader)) };
+        if (!Append(s_startCode) || !Append(nalHeader))
+        {
+            return H264PushResult::Overflow;
+        }
+        m_inFu = true;
+    }
+    else if (!m_inFu)
+    {
+        // start fragment was lost
+        return H264PushResult::Dropped;
+    }
+
+    if (!Append(fragment))
+    {
+        return H264PushResult::Overflow;
+    }
+
+    if ((fuHeader & s_fuEndBit) != 0)
+    {
+        m_inFu = false;
+    }
+
+    return res;
+}
+
+void H264Reassembler::DropFu()
+{
+    m_frameSize = m_fuStart;
+    m_inFu = false;
+}
+
+bool H264Reassembler::AppendNal(std::span<const uint8_t> nal) { return Append(s_startCode) && Append(nal); }
+
+bool H264Reassembler::Append(std::span<const uint8_t> bytes)
+{
+    if (bytes.size() > m_frameBuffer.size() - m_frameSize)
+    {
+        return false;
+    }
+
+    std::memcpy(m_frameBuffer.data() + m_frameSize, bytes.data(), bytes.size());
+    m_frameSize += bytes.size();
+    return true;
+}
+
+} // namespace rtp
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Rtp/RtpHeader.hpp"
+#include "Rtp/RtpPacketView.hpp"
+#include "Rtp/RtpPacketizer.hpp"
+
+namespace rtp
+{
+
+// rfc6184#section-5.2, NAL unit types as used in the RTP payload
+enum H264NalType : uint8_t
+{
+    StapA = 24,
+    FuA = 28,
+};
+
+/**
+FU-A: Fragmentation Unit
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+| FU indicator  |   FU header   |                               |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+                               |
+|                                                               |
+|                         FU payload                            |
+|                                                               |
+|                               +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                               :...OPTIONAL RTP padding        |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+FU indicator    FU header
++---------------+---------------+
+|0|1|2|3|4|5|6|7|0|1|2|3|4|5|6|7|
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|F|NRI|  Type   |S|E|R|  Type   |
++---------------+---------------+
+*/
+
+struct [[gnu::packed]] H264FuAHeader
+{
+    uint8_t indicator;
+    uint8_t header;
+};
+
+/**
+STAP-A: Single-Time Aggregation Packet
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|STAP-A NAL HDR |         NALU 1 Size           | NALU 1 HDR    |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                         NALU 1 Data                           |
+:                                                               :
++               +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|               | NALU 2 Size                   | NALU 2 HDR    |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                         NALU 2 Data                           |
+:                                                               :
+|                               +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                               :...OPTIONAL RTP padding        |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+// Splits an Annex B byte stream on its 3 or 4 byte start codes, writing at most nals.size() NAL units.
+// Returns the number of NAL units found, which may exceed nals.size().
+size_t SplitAnnexB(std::span<const uint8_t> accessUnit, std::span<std::span<const uint8_t>> nals);
+
+/**
+RFC 6184 packetization-mode=1 sender.
+
+Small NAL units that fit together (typically SPS/PPS) are copied into a single STAP-A, NAL units that fit the MTU are
+sent as-is and larger ones are split into FU-A fragments. Only the RTP header and the 1-2 byte payload format prefix
+are written into the pooled slot, the NAL data itself is referenced from the caller's buffer like RtpPacketizer.
+*/
+
+class H264Packetizer
+{
+public:
+    // STAP-A aggregates are copied into the header slot, so keep them to small parameter sets
+    static constexpr size_t s_maxStapSize{ 256 };
+
+    explicit H264Packetizer(const RtpPacketizerConfig& config);
+
+    // Packetizes one access unit given as NAL units without start codes, setting the marker on its last packet.
+    // Returns the number of packets written, or 0 (without consuming sequence numbers) if out or the slot pool is
+    // too small.
+    size_t Packetize(std::span<const std::span<const uint8_t>> nals, uint32_t rtpTimestamp, std::span<RtpOutPacket> out);
+
+    uint16_t NextSeq() const { return m_nextSeq; }
+
+private:
+    struct Slot
+    {
+        std::array<uint8_t, sizeof(RptHeader) + s_maxStapSize> bytes;
+    };
+
+    // Number of packets Packetize would emit for nals
+    size_t CountPackets(std::span<const std::span<const uint8_t>> nals) const;
+
+    // Number of NAL units from the front of nals that aggregate into one STAP-A, 0 or 1 meaning no aggregation
+    size_t StapCount(std::span<const std::span<const uint8_t>> nals) const;
+
+    Slot& NextSlot();
+
+    std::vector<Slot> m_slotPool;
+    size_t m_poolMask;
+    size_t m_poolPos{ 0 };
+    size_t m_maxPayloadSize;
+    uint32_t m_ssrc;
+    uint8_t m_payloadType;
+    uint16_t m_nextSeq;
+};
+
+enum class H264PushResult : uint8_t
+{
+    Incomplete,    // more packets needed for the current access unit
+    FrameComplete, // marker seen, Frame() holds the access unit
+    FrameDamaged,  // marker seen, but a sequence gap or dropped data left Frame() with missing NAL units
+    Dropped,       // sequence gap inside a FU-A or malformed payload, the partial NAL unit was discarded
+    Overflow,      // the frame buffer is full, the current access unit was discarded
+};
+
+/**
+RFC 6184 receiver, reassembles single NAL, STAP-A and FU-A packets into an Annex B access unit.
+
+All output goes into the frame buffer given at construction, nothing is allocated per packet or fragment. Packets must be
+pushed in sequence order (e.g. from a jitter buffer). After FrameComplete or FrameDamaged the next push starts a new
+access unit. Any sequence gap seen while an access unit is assembled, also between single NAL or STAP-A packets, marks
+it damaged.
+*/
+
+class H264Reassembler
+{
+public:
+    explicit H264Reassembler(std::span<uint8_t> frameBuffer) : m_frameBuffer{ frameBuffer } {}
+
+    H264PushResult Push(const RtpPacketView& pkt);
+
+    // The access unit assembled so far, start codes included
+    std::span<const uint8_t> Frame() const { return m_frameBuffer.first(m_frameSize); }
+
+    void Reset();
+
+private:
+    bool AppendNal(std::span<const uint8_t> nal);
+
+    bool Append(std::span<const uint8_t> bytes);
+
+    H264PushResult PushStapA(std::span<const uint8_t> payload);
+
+    H264PushResult PushFuA(std::span<const uint8_t> payload);
+
+    void DropFu();
+
+    std::span<uint8_t> m_frameBuffer;
+    size_t m_frameSize{ 0 };
+    // start of the FU-A NAL unit being reassembled, to roll back on loss
+    size_t m_fuStart{ 0 };
+    bool m_inFu{ false };
+    bool m_frameDone{ false };
+    // a sequence gap or a drop in the current access unit
+    bool m_damaged{ false };
+    // set after an overflow, the rest of that access unit is ignored
+    bool m_skipFrame{ false };
+    bool m_haveSeq{ false };
+    uint16_t m_lastSeq{ 0 };
+    uint32_t m_frameTs{ 0 };
+};
+
+} // namespace rtp
@@ -0,0 +1,73 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include "Rtp/OpusPayload.hpp"
+
+namespace rtp
+{
+
+namespace
+{
+
+// rfc6716#section-3.1 table 2, frame durations at 48 kHz indexed by the low two config bits
+constexpr std::array<uint32_t, 4> s_silkFrameSamples{ 480, 960, 1920, 2880 };
+constexpr std::array<uint32_t, 2> s_hybridFrameSamples{ 480, 960 };
+constexpr std::array<uint32_t, 4> s_celtFrameSamples{ 120, 240, 480, 960 };
+
+constexpr uint8_t s_silkLastConfig{ 11 };
+constexpr uint8_t s_hybridLastConfig{ 15 };
+
+constexpr uint32_t FrameSamples(uint8_t config)
+{
+    if (config <= s_silkLastConfig)
+    {
+        return s_silkFrameSamples[config & 0x3];
+    }
+    if (config <= s_hybridLastConfig)
+    {
+        return s_hybridFrameSamples[config & 0x1];
+    }
+    return s_celtFrameSamples[config & 0x3];
+}
+
+} // namespace
+
+std::optional<uint32_t> OpusPacketSamples(std::span<const uint8_t> opusPacket)
+{
+    if (opusPacket.empty())
+    {
+        return std::nullopt;
+    }
+
+    uint8_t toc{ opusPacket[0] };
+    uint32_t nFrames{};
+    switch (toc & 0x3)
+    {
+        case 0:
+            nFrames = 1;
+            break;
+        case 1:
+        case 2:
+            nFrames = 2;
+            break;
+        default:
+            if (opusPacket.size() < 2)
+            {
+                return std::nullopt;
+            }
+            // rfc6716#section-3.2.5, the frame count byte is |v|p|     M     |
+            nFrames = opusPacket[1] & 0x3F;
+            break;
+    }
+
+    uint32_t samples{ nFrames * FrameSamples(static_cast<uint8_t>(toc >> 3)) };
+    if (samples == 0 || samples > s_opusMaxPacketSamples)
+    {
+        return std::nullopt;
+    }
+    return samples;
+}
+
+} // namespace rtp
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace rtp
+{
+
+// rfc7587#section-4.1, the RTP clock of Opus is 48 kHz whatever bandwidth is coded
+constexpr uint32_t s_opusClockRate{ 48000 };
+
+// rfc7587#section-4.2, one Opus packet per RTP packet, at most 120 ms
+constexpr uint32_t s_opusMaxPacketSamples{ 5760 };
+
+/**
+rfc6716#section-3.1 TOC byte, first of every Opus packet
+
+ 0 1 2 3 4 5 6 7
++-+-+-+-+-+-+-+-+
+| config  |s| c |
++-+-+-+-+-+-+-+-+
+
+config selects mode, bandwidth and frame duration, c the number of frames: 1, 2, 2, or for code 3 the count in the low
+6 bits of the following byte.
+*/
+
+// Samples per channel at 48 kHz the Opus packet decodes to, i.e. how far its RTP timestamp advances.
+// std::nullopt for an empty packet, a code 3 packet without its frame count byte or with no frames, or over 120 ms.
+std::optional<uint32_t> OpusPacketSamples(std::span<const uint8_t> opusPacket);
+
+} // namespace rtp
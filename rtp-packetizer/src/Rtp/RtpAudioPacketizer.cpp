@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include "Rtp/RtpAudioPacketizer.hpp"
+#include "Common/PacketBufferPool.hpp"
+#include "Rtp/OpusPayload.hpp"
+#include "Rtp/RtpHeader.hpp"
+#include "Rtp/RtpPacketizer.hpp"
+
+namespace rtp
+{
+
+RtpAudioPacketizer::RtpAudioPacketizer(const RtpAudioPacketizerConfig& config) :
+    m_ssrc{ config.ssrc },
+    m_initialTs{ config.initialTs },
+    m_clockRate{ config.clockRate },
+    m_payloadType{ config.payloadType },
+    m_nextSeq{ config.initialSeq }
+{
+}
+
+size_t RtpAudioPacketizer::WriteFrame(std::span<const uint8_t> frame, uint32_t samples, std::span<uint8_t> out)
+{
+    size_t pktSize{ sizeof(RptHeader) + frame.size() };
+    if (frame.empty() || out.size() < pktSize)
+    {
+        return 0;
+    }
+
+    // RptHeader is packed, so it can be built straight over the byte buffer
+    FillRtpHeader(
+        *reinterpret_cast<RptHeader*>(out.data()), m_payloadType, m_marker, m_nextSeq, NextTimestamp(), m_ssrc
+    );
+    std::memcpy(out.data() + sizeof(RptHeader), frame.data(), frame.size());
+
+    ++m_nextSeq;
+    m_samples += samples;
+    m_marker = false;
+    return pktSize;
+}
+
+bool RtpAudioPacketizer::WriteFrame(std::span<const uint8_t> frame, uint32_t samples, PacketBuffer& out)
+{
+    size_t pktSize{ WriteFrame(frame, samples, out.Data()) };
+    out.SetSize(pktSize);
+    return pktSize != 0;
+}
+
+size_t RtpAudioPacketizer::WriteOpusFrame(std::span<const uint8_t> frame, std::span<uint8_t> out)
+{
+    auto samples{ OpusPacketSamples(frame) };
+    if (!samples)
+    {
+        return 0;
+    }
+    return WriteFrame(frame, *samples, out);
+}
+
+void RtpAudioPacketizer::Skip(uint32_t samples)
+{
+    if (samples == 0)
+    {
+        return;
+    }
+    m_samples += samples;
+    m_marker = true;
+}
+
+std::chrono::nanoseconds RtpAudioPacketizer::MediaTime() const
+{
+    constexpr uint64_t nsPerSec{ 1'000'000'000 };
+    // split to keep the multiplication inside 64 bits
+    uint64_t ns{ ((m_samples / m_clockRate) * nsPerSec) + (((m_samples % m_clockRate) * nsPerSec) / m_clockRate) };
+    return std::chrono::nanoseconds{ static_cast<int64_t>(ns) };
+}
+
+} // namespace rtp
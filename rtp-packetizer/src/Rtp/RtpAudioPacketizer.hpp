@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "Common/PacketBufferPool.hpp"
+#include "Rtp/OpusPayload.hpp"
+
+namespace rtp
+{
+
+struct RtpAudioPacketizerConfig
+{
+    uint32_t ssrc{ 0 };
+    // rfc7587 leaves it dynamic, 111 is the common choice for Opus
+    uint8_t payloadType{ 111 };
+    uint16_t initialSeq{ 0 };
+    uint32_t initialTs{ 0 };
+    uint32_t clockRate{ s_opusClockRate };
+};
+
+/**
+Emits one RTP packet per audio frame, stamped from a sample clock rather than from capture times.
+
+Each frame advances the timestamp by its duration in samples and the sequence number by one. Discontinuous
+transmission (DTX) is a Skip: the timestamp moves over the silent samples while the sequence number does not, since no
+packet was lost, and the next packet sent carries the marker bit as the first of a talkspurt (rfc3551#section-4.1,
+rfc7587#section-4.2). The very first packet is marked too.
+
+Header and payload are written contiguously into the caller's buffer, typically a pooled PacketBuffer, so the packet
+goes out as a single iovec and the frame buffer can be reused as soon as WriteFrame returns. MediaTime tells how much
+audio has been sent, for pacing the stream against a wall clock (see RtpPacer).
+*/
+
+class RtpAudioPacketizer
+{
+public:
+    explicit RtpAudioPacketizer(const RtpAudioPacketizerConfig& config);
+
+    // Writes the packet carrying frame, samples long, to the start of out and returns its size. Returns 0 (consuming
+    // neither sequence number nor timestamp) if the frame is empty or the packet does not fit.
+    size_t WriteFrame(std::span<const uint8_t> frame, uint32_t samples, std::span<uint8_t> out);
+
+    // Same, into a pooled buffer whose size is set to the packet's
+    bool WriteFrame(std::span<const uint8_t> frame, uint32_t samples, PacketBuffer& out);
+
+    // Opus frame, its duration read from the TOC byte. Returns 0 for a packet OpusPacketSamples rejects.
+    size_t WriteOpusFrame(std::span<const uint8_t> frame, std::span<uint8_t> out);
+
+    // Samples not sent, e.g. during DTX silence. The next packet starts a talkspurt.
+    void Skip(uint32_t samples);
+
+    uint16_t NextSeq() const { return m_nextSeq; }
+
+    uint32_t NextTimestamp() const { return m_initialTs + static_cast<uint32_t>(m_samples); }
+
+    // Samples sent or skipped since the start, not wrapping like the timestamp
+    uint64_t SamplesElapsed() const { return m_samples; }
+
+    // Media time covered by SamplesElapsed, i.e. when the next frame is due relative to the first
+    std::chrono::nanoseconds MediaTime() const;
+
+    uint32_t ClockRate() const { return m_clockRate; }
+
+private:
+    uint64_t m_samples{ 0 };
+    uint32_t m_ssrc;
+    uint32_t m_initialTs;
+    uint32_t m_clockRate;
+    uint8_t m_payloadType;
+    uint16_t m_nextSeq;
+    bool m_marker{ true };
+};
+
+} // namespace rtp
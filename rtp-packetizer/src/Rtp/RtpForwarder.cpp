@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <endian.h>
+#include <span>
+#include <sys/uio.h>
+#include "Rtp/RtpForwarder.hpp"
+#include "Rtp/RtpHeader.hpp"
+#include "Rtp/RtpPacketizer.hpp"
+
+namespace rtp
+{
+
+RtpForwarder::RtpForwarder(const RtpForwarderConfig& config) :
+    m_headerPool(std::bit_ceil(std::max<size_t>(config.headerPoolSize, 1))),
+    m_poolMask{ m_headerPool.size() - 1 }
+{
+}
+
+size_t RtpForwarder::Forward(
+    std::span<const uint8_t> rawPkt, std::span<const RtpForwardLeg> legs, std::span<RtpOutPacket> out
+)
+{
+    if (rawPkt.size() < sizeof(RptHeader) || legs.size() > out.size() || legs.size() > m_headerPool.size())
+    {
+        return 0;
+    }
+
+    RptHeader source;
+    std::memcpy(&source, rawPkt.data(), sizeof(RptHeader));
+    if (source.version != 2)
+    {
+        return 0;
+    }
+
+    uint16_t seq{ be16toh(source.seq) };
+    uint32_t ts{ be32toh(source.ts) };
+    auto rest{ rawPkt.subspan(sizeof(RptHeader)) };
+
+    for (size_t i{ 0 }; i < legs.size(); ++i)
+    {
+        const auto& leg{ legs[i] };
+        auto& header{ NextHeaderSlot() };
+        header = source;
+        header.seq = htobe16(static_cast<uint16_t>(seq + leg.seqOffset));
+        header.ts = htobe32(ts + leg.tsOffset);
+        header.ssrc = htobe32(leg.ssrc);
+
+        out[i].iov[0] = iovec{ .iov_base = &header, .iov_len = sizeof(RptHeader) };
+        // iovec is not const-correct, the shared part is only ever read
+        out[i].iov[1] = iovec{ .iov_base = const_cast<uint8_t*>(rest.data()), .iov_len = rest.size() };
+    }
+
+    return legs.size();
+}
+
+RptHeader& RtpForwarder::NextHeaderSlot()
+{
+    auto& slot{ m_headerPool[m_poolPos & m_poolMask] };
+    ++m_poolPos;
+    return slot;
+}
+
+} // namespace rtp
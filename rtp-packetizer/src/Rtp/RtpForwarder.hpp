@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Rtp/RtpHeader.hpp"
+#include "Rtp/RtpPacketizer.hpp"
+
+namespace rtp
+{
+
+// How one subscriber sees a forwarded stream, offsets are added modulo 2^16 and 2^32
+struct RtpForwardLeg
+{
+    uint32_t ssrc{ 0 };
+    uint16_t seqOffset{ 0 };
+    uint32_t tsOffset{ 0 };
+};
+
+struct RtpForwarderConfig
+{
+    // number of reusable header slots, a power of two covering the legs of every packet in one sendmmsg batch
+    size_t headerPoolSize{ 1024 };
+};
+
+/**
+Fans one received RTP packet out to many subscribers without copying it.
+
+Each leg gets its own copy of the 12 byte fixed header, with the leg's SSRC and the sequence number and timestamp moved
+by its offsets, in a header slot owned by the forwarder. Everything after the fixed header (CSRCs, header extension,
+payload, padding) is shared by every leg and points into the received buffer, so an outgoing packet is two iovec
+entries ready to be the msg_iov of an mmsghdr, like the ones RtpPacketizer emits. Header slots are reused round robin:
+a packet stays valid until headerPoolSize further packets have been emitted, and the received buffer (e.g. its
+PacketBuffer) must outlive the send.
+
+The packet is forwarded as received. With SRTP, unprotect it first and protect per leg, which needs a copy per leg.
+*/
+
+class RtpForwarder
+{
+public:
+    explicit RtpForwarder(const RtpForwarderConfig& config = {});
+
+    // Writes one packet per leg to out, in leg order, and returns the number written. Returns 0 if rawPkt is not an RTP
+    // packet, out is smaller than legs, or the legs need more header slots than the pool holds.
+    size_t Forward(std::span<const uint8_t> rawPkt, std::span<const RtpForwardLeg> legs, std::span<RtpOutPacket> out);
+
+    size_t HeaderPoolSize() const { return m_headerPool.size(); }
+
+private:
+    RptHeader& NextHeaderSlot();
+
+    std::vector<RptHeader> m_headerPool;
+    size_t m_poolMask;
+    size_t m_poolPos{ 0 };
+};
+
+} // namespace rtp
@@ -50,7 +50,32 @@ struct [[gnu::packed]] RptHeader
     uint16_t seq;
     uint32_t ts;
     uint32_t ssrc;
-    uint32_t csrc;
+};
+
+/**
+RTP Header Extension, follows the CSRC list when X is set
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|      defined by profile       |           length              |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                        header extension                       |
+|                             ....                              |
+*/
+
+struct [[gnu::packed]] RtpExtensionHeader
+{
+    uint16_t profile;
+    uint16_t length;
+};
+
+enum RtpExtProfile : uint16_t
+{
+    // rfc8285#section-4.2
+    OneByte = 0xBEDE,
+    // rfc8285#section-4.3, the low 4 "appbits" are ignored
+    TwoByte = 0x1000,
 };
 
 } // namespace rtp
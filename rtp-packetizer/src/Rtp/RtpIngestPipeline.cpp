@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <endian.h>
+#include <memory>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include "Rtp/RtpIngestPipeline.hpp"
+#include "Common/ByteOrder.hpp"
+#include "Common/PacketBufferPool.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtcp/RtcpParser.hpp"
+#include "Rtp/RtpParser.hpp"
+
+namespace rtp
+{
+
+namespace
+{
+
+// packets taken from one ring before moving on to the next, so a busy receiver cannot starve the others
+constexpr size_t s_drainBatch{ 64 };
+
+// rfc5761#section-4, RTCP packet types occupy 192-223 of the second byte
+constexpr uint8_t s_rtcpTypeFirst{ 192 };
+constexpr uint8_t s_rtcpTypeLast{ 223 };
+
+// common header + sender SSRC
+constexpr size_t s_minRtcpSize{ 8 };
+constexpr size_t s_minRtpSize{ 12 };
+constexpr size_t s_rtcpSsrcOffset{ 4 };
+constexpr size_t s_rtpSsrcOffset{ 8 };
+
+// Single writer, so a plain load/store pair is enough and avoids a locked read-modify-write
+void Bump(std::atomic<uint64_t>& cell, uint64_t n = 1)
+{
+    cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+void Accumulate(RtpIngestCounters& total, const detail::RtpIngestCounterCells& cells)
+{
+    total.submitted += cells.submitted.load(std::memory_order_relaxed);
+    total.malformed += cells.malformed.load(std::memory_order_relaxed);
+    total.queueFull += cells.queueFull.load(std::memory_order_relaxed);
+    total.refused += cells.refused.load(std::memory_order_relaxed);
+    total.rtp += cells.rtp.load(std::memory_order_relaxed);
+    total.rtcp += cells.rtcp.load(std::memory_order_relaxed);
+    total.played += cells.played.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+RtpIngestShard::RtpIngestShard(size_t index, const RtpIngestConfig& cfg) :
+    m_index{ index },
+    m_playoutDelay{ cfg.playoutDelay },
+    m_stats{ cfg.maxSourcesPerShard, cfg.clockRate }
+{
+    m_jitterBuffers.reserve(cfg.maxSourcesPerShard);
+}
+
+const RtpIngestShard::JitterBuffer* RtpIngestShard::FindJitterBuffer(uint32_t ssrc) const
+{
+    auto it{ m_jitterBuffers.find(ssrc) };
+    return it != m_jitterBuffers.end() ? it->second.get() : nullptr;
+}
+
+void RtpIngestShard::Remove(uint32_t ssrc)
+{
+    m_stats.Remove(ssrc);
+    m_jitterBuffers.erase(ssrc);
+}
+
+RtpIngestPipeline::RtpIngestPipeline(const RtpIngestConfig& cfg, RtpIngestHandlers handlers) :
+    m_cfg{ cfg },
+    m_handlers{ std::move(handlers) }
+{
+    m_cfg.nReceivers = std::max<size_t>(m_cfg.nReceivers, 1);
+    m_cfg.nShards = std::max<size_t>(m_cfg.nShards, 1);
+
+    m_shards.reserve(m_cfg.nShards);
+    for (size_t i{ 0 }; i < m_cfg.nShards; ++i)
+    {
+        // private constructor, make_unique cannot reach it
+        m_shards.push_back(std::unique_ptr<RtpIngestShard>{ new RtpIngestShard{ i, m_cfg } });
+    }
+
+    m_rings.reserve(m_cfg.nShards * m_cfg.nReceivers);
+    for (size_t i{ 0 }; i < m_cfg.nShards * m_cfg.nReceivers; ++i)
+    {
+        m_rings.emplace_back(std::make_unique<SpscRing<detail::RtpIngestItem>>(m_cfg.ringCapacity));
+    }
+
+    m_receiverCounters = std::make_unique<detail::RtpIngestCounterCells[]>(m_cfg.nReceivers);
+}
+
+RtpIngestPipeline::~RtpIngestPipeline() { Stop(); }
+
+void RtpIngestPipeline::Start()
+{
+    if (!m_workers.empty())
+    {
+        return;
+    }
+
+    m_workers.reserve(m_shards.size());
+    for (auto& shard : m_shards)
+    {
+        m_workers.emplace_back([this, &shard = *shard](std::stop_token stop) { Run(shard, std::move(stop)); });
+    }
+}
+
+void RtpIngestPipeline::Stop()
+{
+    for (auto& worker : m_workers)
+    {
+        worker.request_stop();
+    }
+    m_workers.clear();
+}
+
+size_t RtpIngestPipeline::ShardOf(uint32_t ssrc) const
+{
+    // high bits of the multiplicative hash, its low bits only depend on the low SSRC bits
+    uint64_t hash{ ssrc * 0x9E3779B1U };
+    return static_cast<size_t>((hash * m_shards.size()) >> 32);
+}
+
+bool RtpIngestPipeline::Submit(size_t receiver, PacketBuffer&& pkt, Clock::time_point arrival)
+{
+    auto& counters{ m_receiverCounters[receiver] };
+    auto bytes{ pkt.Bytes() };
+
+    // version 2 in the top bits of the first byte for both
+    bool valid{ bytes.size() >= s_minRtcpSize && (bytes[0] >> 6) == 2 };
+    bool rtcp{ valid && bytes[1] >= s_rtcpTypeFirst && bytes[1] <= s_rtcpTypeLast };
+    if (!valid || (!rtcp && bytes.size() < s_minRtpSize))
+    {
+        Bump(counters.malformed);
+        pkt.Reset();
+        return false;
+    }
+
+    uint32_t ssrc{ LoadBe32(bytes.data() + (rtcp ? s_rtcpSsrcOffset : s_rtpSsrcOffset)) };
+    detail::RtpIngestItem item{ .pkt = std::move(pkt), .arrival = arrival, .rtcp = rtcp };
+    if (!Ring(receiver, ShardOf(ssrc)).TryPush(item))
+    {
+        Bump(counters.queueFull);
+        item.pkt.Reset();
+        return false;
+    }
+
+    Bump(counters.submitted);
+    return true;
+}
+
+RtpIngestCounters RtpIngestPipeline::Counters() const
+{
+    RtpIngestCounters total{};
+    for (size_t i{ 0 }; i < m_cfg.nReceivers; ++i)
+    {
+        Accumulate(total, m_receiverCounters[i]);
+    }
+    for (const auto& shard : m_shards)
+    {
+        Accumulate(total, shard->m_counters);
+    }
+    return total;
+}
+
+void RtpIngestPipeline::Run(RtpIngestShard& shard, std::stop_token stop)
+{
+    while (!stop.stop_requested())
+    {
+        size_t nHandled{ Drain(shard) };
+
+        auto now{ Clock::now() };
+        PlayOut(shard, now);
+        if (m_handlers.onPoll)
+        {
+            m_handlers.onPoll(shard, now);
+        }
+
+        if (nHandled == 0)
+        {
+            std::this_thread::sleep_for(m_cfg.idleSleep);
+        }
+    }
+}
+
+size_t RtpIngestPipeline::Drain(RtpIngestShard& shard)
+{
+    size_t nHandled{ 0 };
+    for (size_t receiver{ 0 }; receiver < m_cfg.nReceivers; ++receiver)
+    {
+        auto& ring{ Ring(receiver, shard.m_index) };
+        for (size_t n{ 0 }; n < s_drainBatch; ++n)
+        {
+            auto item{ ring.TryPop() };
+            if (!item)
+            {
+                break;
+            }
+
+            if (item->rtcp)
+            {
+                HandleRtcp(shard, std::move(item->pkt), item->arrival);
+            }
+            else
+            {
+                HandleRtp(shard, std::move(item->pkt), item->arrival);
+            }
+            ++nHandled;
+        }
+    }
+    return nHandled;
+}
+
+void RtpIngestPipeline::HandleRtp(RtpIngestShard& shard, PacketBuffer&& pkt, Clock::time_point arrival)
+{
+    auto view{ ParseRtp(pkt.Bytes()) };
+    if (!view)
+    {
+        Bump(shard.m_counters.malformed);
+        return;
+    }
+
+    // the stats table bounds the number of sources, so a refused source gets no jitter buffer either
+    if (!shard.m_stats.OnRtp(*view, arrival))
+    {
+        Bump(shard.m_counters.refused);
+        return;
+    }
+    Bump(shard.m_counters.rtp);
+
+    uint32_t ssrc{ be32toh(view->header->ssrc) };
+    auto seq{ be16toh(view->header->seq) };
+    auto& jitterBuffer{ shard.m_jitterBuffers[ssrc] };
+    if (!jitterBuffer)
+    {
+        jitterBuffer = std::make_unique<RtpIngestShard::JitterBuffer>(shard.m_playoutDelay);
+    }
+    jitterBuffer->Insert(seq, std::move(pkt), arrival);
+}
+
+void RtpIngestPipeline::HandleRtcp(RtpIngestShard& shard, PacketBuffer&& pkt, Clock::time_point arrival)
+{
+    auto onSenderReport{ [&shard, arrival](const RtcpSenderReportView& sr) {
+        shard.m_stats.OnSenderReport(sr, arrival);
+    } };
+    if (!ParseRtcp(pkt.Bytes(), onSenderReport))
+    {
+        Bump(shard.m_counters.malformed);
+        return;
+    }
+    Bump(shard.m_counters.rtcp);
+
+    if (m_handlers.onRtcp)
+    {
+        m_handlers.onRtcp(shard, pkt.Bytes());
+    }
+}
+
+void RtpIngestPipeline::PlayOut(RtpIngestShard& shard, Clock::time_point now)
+{
+    for (auto& [ssrc, jitterBuffer] : shard.m_jitterBuffers)
+    {
+        while (auto played{ jitterBuffer->Pop(now) })
+        {
+            Bump(shard.m_counters.played);
+            if (m_handlers.onPlayout)
+            {
+                m_handlers.onPlayout(shard, ssrc, std::move(*played));
+            }
+        }
+    }
+}
+
+} // namespace rtp
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Common/PacketBufferPool.hpp"
+#include "Common/SpscRing.hpp"
+#include "Rtp/RtpJitterBuffer.hpp"
+#include "Rtp/RtpReceiverStats.hpp"
+
+namespace rtp
+{
+
+struct RtpIngestConfig
+{
+    size_t nReceivers{ 1 };
+    size_t nShards{ 1 };
+    // slots of each receiver-to-shard ring
+    size_t ringCapacity{ 1024 };
+    size_t maxSourcesPerShard{ 256 };
+    uint32_t clockRate{ 90000 };
+    std::chrono::steady_clock::duration playoutDelay{ std::chrono::milliseconds{ 50 } };
+    // how long a worker that found all its rings empty sleeps before polling again
+    std::chrono::steady_clock::duration idleSleep{ std::chrono::microseconds{ 100 } };
+};
+
+// Summed over every receiver and shard, see RtpIngestPipeline::Counters
+struct RtpIngestCounters
+{
+    // queued to a shard
+    uint64_t submitted{ 0 };
+    // not RTP/RTCP by their first bytes, or rejected by the shard's parse
+    uint64_t malformed{ 0 };
+    // dropped because the shard's ring was full
+    uint64_t queueFull{ 0 };
+    // RTP from a new source arriving while the shard's source table was full
+    uint64_t refused{ 0 };
+    uint64_t rtp{ 0 };
+    uint64_t rtcp{ 0 };
+    uint64_t played{ 0 };
+};
+
+namespace detail
+{
+
+// One writer each, readers only take relaxed snapshots
+struct alignas(64) RtpIngestCounterCells
+{
+    std::atomic<uint64_t> submitted{ 0 };
+    std::atomic<uint64_t> malformed{ 0 };
+    std::atomic<uint64_t> queueFull{ 0 };
+    std::atomic<uint64_t> refused{ 0 };
+    std::atomic<uint64_t> rtp{ 0 };
+    std::atomic<uint64_t> rtcp{ 0 };
+    std::atomic<uint64_t> played{ 0 };
+};
+
+struct RtpIngestItem
+{
+    PacketBuffer pkt;
+    std::chrono::steady_clock::time_point arrival;
+    bool rtcp;
+};
+
+} // namespace detail
+
+/**
+State of one worker: receiver statistics and a jitter buffer per source, touched only by the worker's thread.
+
+Handlers get the shard they run on and may use it freely, e.g. to build receiver reports from Stats() in onPoll.
+*/
+
+class RtpIngestShard
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using JitterBuffer = RtpJitterBuffer<PacketBuffer>;
+
+    RtpIngestShard(const RtpIngestShard&) = delete;
+    RtpIngestShard& operator=(const RtpIngestShard&) = delete;
+
+    size_t Index() const { return m_index; }
+
+    RtpReceiverStats& Stats() { return m_stats; }
+
+    const JitterBuffer* FindJitterBuffer(uint32_t ssrc) const;
+
+    // Forgets a source and drops its buffered packets, e.g. on BYE. Not from onPlayout, which iterates the sources.
+    void Remove(uint32_t ssrc);
+
+private:
+    friend class RtpIngestPipeline;
+
+    RtpIngestShard(size_t index, const RtpIngestConfig& cfg);
+
+    size_t m_index;
+    Clock::duration m_playoutDelay;
+    RtpReceiverStats m_stats;
+    std::unordered_map<uint32_t, std::unique_ptr<JitterBuffer>> m_jitterBuffers;
+    detail::RtpIngestCounterCells m_counters;
+};
+
+struct RtpIngestHandlers
+{
+    // Packets of one source in sequence order, once their playout delay has passed
+    std::function<void(RtpIngestShard&, uint32_t ssrc, RtpPlayoutPacket<PacketBuffer>&&)> onPlayout;
+    // Every valid compound RTCP packet, after its sender reports were fed into the shard's statistics
+    std::function<void(RtpIngestShard&, std::span<const uint8_t> rtcp)> onRtcp;
+    // Once per worker loop, after draining the rings and playing out what is due
+    std::function<void(RtpIngestShard&, RtpIngestShard::Clock::time_point now)> onPoll;
+};
+
+/**
+Multi-threaded RTP/RTCP ingest, sharded by SSRC.
+
+Each of the nReceivers receive threads hands its datagrams to Submit with its own receiver index. Datagrams are told
+apart as RTP or RTCP by their second byte (rfc5761#section-4) and hashed by SSRC, the RTP SSRC or the RTCP sender SSRC,
+onto one of nShards workers. Every receiver has its own bounded SPSC ring to every shard, so no two threads ever share
+a queue end and nothing on the packet path takes a lock. A worker owns all the state of its sources: parsing, receiver
+statistics and jitter buffering happen on one thread per source, which keeps each stream in order.
+
+A sender's SR carries its media SSRC, so it lands on the same shard as that source's RTP and its LSR is recorded there.
+Handlers run on the worker threads, concurrently for different shards.
+*/
+
+class RtpIngestPipeline
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RtpIngestPipeline(const RtpIngestConfig& cfg, RtpIngestHandlers handlers);
+
+    RtpIngestPipeline(const RtpIngestPipeline&) = delete;
+    RtpIngestPipeline& operator=(const RtpIngestPipeline&) = delete;
+
+    // Stops the workers, buffered packets are dropped
+    ~RtpIngestPipeline();
+
+    // Starts one worker thread per shard
+    void Start();
+
+    // Asks the workers to exit and joins them. Submitted packets not yet drained stay queued.
+    void Stop();
+
+    // Receive thread side, only ever called from the thread owning receiver. On false the datagram was dropped, being
+    // neither RTP nor RTCP or finding its shard's ring full, and pkt is released.
+    bool Submit(size_t receiver, PacketBuffer&& pkt, Clock::time_point arrival);
+
+    // Shard a source's packets go to
+    size_t ShardOf(uint32_t ssrc) const;
+
+    size_t ShardCount() const { return m_shards.size(); }
+
+    // Relaxed snapshot, safe from any thread
+    RtpIngestCounters Counters() const;
+
+private:
+    SpscRing<detail::RtpIngestItem>& Ring(size_t receiver, size_t shard)
+    {
+        return *m_rings[(shard * m_cfg.nReceivers) + receiver];
+    }
+
+    void Run(RtpIngestShard& shard, std::stop_token stop);
+
+    // Pops up to a batch from each of the shard's rings, returns the number of packets handled
+    size_t Drain(RtpIngestShard& shard);
+
+    void HandleRtp(RtpIngestShard& shard, PacketBuffer&& pkt, Clock::time_point arrival);
+
+    void HandleRtcp(RtpIngestShard& shard, PacketBuffer&& pkt, Clock::time_point arrival);
+
+    void PlayOut(RtpIngestShard& shard, Clock::time_point now);
+
+    RtpIngestConfig m_cfg;
+    RtpIngestHandlers m_handlers;
+    std::vector<std::unique_ptr<RtpIngestShard>> m_shards;
+    // shard-major, see Ring
+    std::vector<std::unique_ptr<SpscRing<detail::RtpIngestItem>>> m_rings;
+    std::unique_ptr<detail::RtpIngestCounterCells[]> m_receiverCounters;
+    std::vector<std::jthread> m_workers;
+};
+
+} // namespace rtp
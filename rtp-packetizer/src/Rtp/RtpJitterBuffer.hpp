@@ -0,0 +1,219 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace rtp
+{
+
+enum class RtpJitterInsert : uint8_t
+{
+    Inserted,
+    Duplicate, // same sequence number is already buffered
+    Late,      // at most Capacity behind the playout point, already played out or declared lost
+    Resync,    // outside the buffer window either way, the buffer was flushed and restarted at this packet
+};
+
+struct RtpJitterBufferStats
+{
+    uint64_t inserted{ 0 };
+    uint64_t played{ 0 };
+    uint64_t lost{ 0 };
+    uint64_t late{ 0 };
+    uint64_t duplicate{ 0 };
+    // buffered packets thrown away by a resync
+    uint64_t flushed{ 0 };
+    uint64_t resyncs{ 0 };
+};
+
+template<typename Packet>
+struct RtpPlayoutPacket
+{
+    Packet pkt;
+    uint16_t seq;
+    // sequence numbers skipped as lost right before this packet
+    uint16_t nLostBefore;
+};
+
+/**
+Reorder/jitter buffer keyed on the RTP sequence number (RptHeader::seq in host byte order).
+
+Storage is a fixed power-of-two ring indexed by seq, with an occupancy bitmap for finding the next buffered packet, so
+nothing is allocated per packet and the whole buffer lives inline in the object. A packet is released playoutDelay after
+it arrived. When the next expected packet is missing, it is declared lost once a later packet becomes due.
+
+Packet is whatever handle the caller wants to buffer (a view, a pool index, ...), it should be cheap to move.
+*/
+
+template<typename Packet, size_t Capacity = 512>
+class RtpJitterBuffer
+{
+    static_assert(std::has_single_bit(Capacity), "capacity must be a power of two");
+    static_assert(Capacity <= 0x8000, "capacity must fit inside half the sequence number space");
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RtpJitterBuffer(Clock::duration playoutDelay) : m_playoutDelay{ playoutDelay } {}
+
+    RtpJitterInsert Insert(uint16_t seq, Packet pkt, Clock::time_point arrival)
+    {
+        if (!m_started)
+        {
+            m_started = true;
+            m_headSeq = seq;
+        }
+
+        // unsigned distances handle the 16-bit wraparound, only up to Capacity behind the head counts as late: a jump
+        // of half the sequence space or more, e.g. a sender restart, must not be rejected for the next 32k packets
+        auto ahead{ static_cast<uint16_t>(seq - m_headSeq) };
+        auto behind{ static_cast<uint16_t>(m_headSeq - seq) };
+        if (ahead >= Capacity && behind <= Capacity)
+        {
+            ++m_stats.late;
+            return RtpJitterInsert::Late;
+        }
+
+        auto res{ RtpJitterInsert::Inserted };
+        if (ahead >= Capacity)
+        {
+            Flush();
+            m_headSeq = seq;
+            ++m_stats.resyncs;
+            res = RtpJitterInsert::Resync;
+        }
+
+        size_t idx{ seq & s_mask };
+        if (IsOccupied(idx))
+        {
+            ++m_stats.duplicate;
+            return RtpJitterInsert::Duplicate;
+        }
+
+        m_slots[idx] = Slot{ .pkt = std::move(pkt), .arrival = arrival };
+        SetOccupied(idx, true);
+        ++m_size;
+        ++m_stats.inserted;
+        return res;
+    }
+
+    // Releases the next packet in sequence order if it is due at now
+    std::optional<RtpPlayoutPacket<Packet>> Pop(Clock::time_point now)
+    {
+        if (m_size == 0)
+        {
+            return std::nullopt;
+        }
+
+        auto nextIdx{ NextOccupied(m_headSeq & s_mask) };
+        auto& slot{ m_slots[nextIdx] };
+        if (now < slot.arrival + m_playoutDelay)
+        {
+            return std::nullopt;
+        }
+
+        auto nLost{ static_cast<uint16_t>((nextIdx - m_headSeq) & s_mask) };
+        auto seq{ static_cast<uint16_t>(m_headSeq + nLost) };
+        m_stats.lost += nLost;
+        ++m_stats.played;
+
+        SetOccupied(nextIdx, false);
+        --m_size;
+        m_headSeq = static_cast<uint16_t>(seq + 1);
+
+        return RtpPlayoutPacket<Packet>{ .pkt = std::move(slot.pkt), .seq = seq, .nLostBefore = nLost };
+    }
+
+    void SetPlayoutDelay(Clock::duration playoutDelay) { m_playoutDelay = playoutDelay; }
+
+    // Drops every buffered packet and forgets the playout point
+    void Reset()
+    {
+        Flush();
+        m_started = false;
+    }
+
+    size_t Size() const { return m_size; }
+
+    bool Empty() const { return m_size == 0; }
+
+    // Next sequence number to be played out
+    uint16_t HeadSeq() const { return m_headSeq; }
+
+    const RtpJitterBufferStats& Stats() const { return m_stats; }
+
+private:
+    static constexpr size_t s_mask{ Capacity - 1 };
+    static constexpr size_t s_wordBits{ 64 };
+    static constexpr size_t s_nWords{ (Capacity + s_wordBits - 1) / s_wordBits };
+
+    struct Slot
+    {
+        Packet pkt;
+        Clock::time_point arrival;
+    };
+
+    bool IsOccupied(size_t idx) const { return ((m_occupied[idx / s_wordBits] >> (idx % s_wordBits)) & 1) != 0; }
+
+    void SetOccupied(size_t idx, bool occupied)
+    {
+        uint64_t bit{ uint64_t{ 1 } << (idx % s_wordBits) };
+        if (occupied)
+        {
+            m_occupied[idx / s_wordBits] |= bit;
+        }
+        else
+        {
+            m_occupied[idx / s_wordBits] &= ~bit;
+        }
+    }
+
+    // First occupied slot at or after from, wrapping around. Only valid while m_size > 0.
+    size_t NextOccupied(size_t from) const
+    {
+        size_t word{ from / s_wordBits };
+        uint64_t bits{ m_occupied[word] & (~uint64_t{ 0 } << (from % s_wordBits)) };
+        for (size_t n{ 0 }; n <= s_nWords; ++n)
+        {
+            if (bits != 0)
+            {
+                return (word * s_wordBits) + static_cast<size_t>(std::countr_zero(bits));
+            }
+
+            word = (word + 1) % s_nWords;
+            bits = m_occupied[word];
+        }
+
+        return from;
+    }
+
+    void Flush()
+    {
+        m_stats.flushed += m_size;
+        for (size_t i{ 0 }; i < Capacity && m_size > 0; ++i)
+        {
+            if (IsOccupied(i))
+            {
+                m_slots[i].pkt = Packet{};
+                --m_size;
+            }
+        }
+        m_occupied = {};
+        m_size = 0;
+    }
+
+    std::array<Slot, Capacity> m_slots{};
+    std::array<uint64_t, s_nWords> m_occupied{};
+    Clock::duration m_playoutDelay;
+    RtpJitterBufferStats m_stats{};
+    size_t m_size{ 0 };
+    uint16_t m_headSeq{ 0 };
+    bool m_started{ false };
+};
+
+} // namespace rtp
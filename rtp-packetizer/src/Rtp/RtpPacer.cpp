@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "Rtp/RtpPacer.hpp"
+
+namespace rtp
+{
+
+RtpPacer::RtpPacer(const RtpPacerConfig& config, Clock::time_point start) :
+    m_slots(std::bit_ceil(std::max<size_t>(config.slots, 1)), s_nil),
+    m_start{ start },
+    m_tick{ std::max(config.tick, std::chrono::nanoseconds{ 1 }) },
+    m_slotMask{ m_slots.size() - 1 }
+{
+    m_entries.reserve(config.streams);
+    m_firing.reserve(config.streams);
+}
+
+void RtpPacer::Schedule(uint32_t id, Clock::time_point due)
+{
+    if (id == s_nil)
+    {
+        return;
+    }
+    if (id >= m_entries.size())
+    {
+        m_entries.resize(size_t{ id } + 1);
+    }
+
+    auto& entry{ m_entries[id] };
+    if (entry.state == EntryState::Scheduled)
+    {
+        Unlink(id);
+    }
+    entry.due = due;
+    // a tick already walked would only be seen a full round later
+    entry.dueTick = std::max(TickOf(due), m_nextTick);
+    Link(id);
+}
+
+void RtpPacer::Cancel(uint32_t id)
+{
+    if (id >= m_entries.size())
+    {
+        return;
+    }
+
+    auto& entry{ m_entries[id] };
+    if (entry.state == EntryState::Scheduled)
+    {
+        Unlink(id);
+    }
+    entry.state = EntryState::Idle;
+}
+
+std::optional<RtpPacer::Clock::time_point> RtpPacer::NextWakeup() const
+{
+    if (m_pending == 0)
+    {
+        return std::nullopt;
+    }
+
+    for (uint64_t tick{ m_nextTick }; tick < m_nextTick + m_slots.size(); ++tick)
+    {
+        if (m_slots[static_cast<size_t>(tick) & m_slotMask] != s_nil)
+        {
+            return m_start + (m_tick * static_cast<int64_t>(tick));
+        }
+    }
+    return std::nullopt;
+}
+
+uint64_t RtpPacer::TickOf(Clock::time_point t) const
+{
+    if (t <= m_start)
+    {
+        return 0;
+    }
+
+    auto elapsed{ std::chrono::duration_cast<std::chrono::nanoseconds>(t - m_start) };
+    return static_cast<uint64_t>((elapsed + m_tick - std::chrono::nanoseconds{ 1 }) / m_tick);
+}
+
+void RtpPacer::Link(uint32_t id)
+{
+    auto& entry{ m_entries[id] };
+    auto& head{ m_slots[static_cast<size_t>(entry.dueTick) & m_slotMask] };
+    entry.prev = s_nil;
+    entry.next = head;
+    if (head != s_nil)
+    {
+        m_entries[head].prev = id;
+    }
+    head = id;
+    entry.state = EntryState::Scheduled;
+    ++m_pending;
+}
+
+void RtpPacer::Unlink(uint32_t id)
+{
+    auto& entry{ m_entries[id] };
+    if (entry.prev != s_nil)
+    {
+        m_entries[entry.prev].next = entry.next;
+    }
+    else
+    {
+        m_slots[static_cast<size_t>(entry.dueTick) & m_slotMask] = entry.next;
+    }
+    if (entry.next != s_nil)
+    {
+        m_entries[entry.next].prev = entry.prev;
+    }
+    entry.prev = s_nil;
+    entry.next = s_nil;
+    entry.state = EntryState::Idle;
+    --m_pending;
+}
+
+void RtpPacer::Collect(size_t slot, uint64_t nowTick)
+{
+    uint32_t id{ m_slots[slot] };
+    while (id != s_nil)
+    {
+        auto& entry{ m_entries[id] };
+        uint32_t next{ entry.next };
+        if (entry.dueTick <= nowTick)
+        {
+            Unlink(id);
+            entry.state = EntryState::Firing;
+            m_firing.push_back(id);
+        }
+        id = next;
+    }
+}
+
+} // namespace rtp
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace rtp
+{
+
+struct RtpPacerConfig
+{
+    std::chrono::nanoseconds tick{ std::chrono::milliseconds{ 1 } };
+    // wheel size, a power of two; deadlines further than slots ticks ahead wait in their slot for later rounds
+    size_t slots{ 256 };
+    // stream ids expected, ids are indices so they should be dense from 0
+    size_t streams{ 0 };
+};
+
+/**
+Send scheduler for many paced streams, one hashed timer wheel instead of a timer per stream.
+
+Each stream has at most one pending deadline, kept in the wheel slot of its tick in an intrusive list threaded through
+a per-stream entry, so Schedule, Cancel and rescheduling from inside a callback are O(1) and allocation free once every
+id was seen. Advance walks the slots of the ticks elapsed since the previous call and fires each stream whose deadline
+tick has passed, so deadlines fire up to one tick late and never early.
+
+Typical audio loop: on fire, write the stream's next frame into a pooled buffer with RtpAudioPacketizer::WriteFrame,
+queue it for sendmmsg, then Schedule the stream again at its start time plus MediaTime(). Rescheduling from media time
+rather than from the firing time keeps tick rounding from accumulating into drift.
+*/
+
+class RtpPacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RtpPacer(const RtpPacerConfig& config, Clock::time_point start);
+
+    // Replaces any pending deadline of id. A deadline already passed fires on the next Advance.
+    void Schedule(uint32_t id, Clock::time_point due);
+
+    void Cancel(uint32_t id);
+
+    bool Scheduled(uint32_t id) const { return id < m_entries.size() && m_entries[id].state == EntryState::Scheduled; }
+
+    // Number of pending deadlines
+    size_t Pending() const { return m_pending; }
+
+    // Fires fn(id, due) for every deadline up to now and returns how many fired. fn may Schedule or Cancel any id: one
+    // not fired yet is then left out of this call, and a deadline on a tick already walked fires on the next one.
+    template<typename Fn>
+    size_t Advance(Clock::time_point now, Fn&& fn);
+
+    // Start of the earliest non-empty slot, when to call Advance next. std::nullopt if nothing is pending. May be
+    // early when that slot only holds deadlines of later rounds.
+    std::optional<Clock::time_point> NextWakeup() const;
+
+private:
+    static constexpr uint32_t s_nil{ UINT32_MAX };
+
+    enum class EntryState : uint8_t
+    {
+        Idle,
+        Scheduled, // linked into its slot
+        Firing,    // collected by the running Advance
+    };
+
+    struct Entry
+    {
+        uint64_t dueTick{ 0 };
+        Clock::time_point due{};
+        uint32_t prev{ s_nil };
+        uint32_t next{ s_nil };
+        EntryState state{ EntryState::Idle };
+    };
+
+    // Tick a time point falls due on, rounded up so nothing fires early
+    uint64_t TickOf(Clock::time_point t) const;
+
+    void Link(uint32_t id);
+
+    void Unlink(uint32_t id);
+
+    // Moves the deadlines of slot that are due by nowTick to m_firing, as Firing
+    void Collect(size_t slot, uint64_t nowTick);
+
+    std::vector<Entry> m_entries;
+    // head of each slot's list
+    std::vector<uint32_t> m_slots;
+    // scratch of Advance, kept to avoid allocating per call
+    std::vector<uint32_t> m_firing;
+    Clock::time_point m_start;
+    std::chrono::nanoseconds m_tick;
+    size_t m_slotMask;
+    // first tick not walked yet
+    uint64_t m_nextTick{ 0 };
+    size_t m_pending{ 0 };
+};
+
+template<typename Fn>
+size_t RtpPacer::Advance(Clock::time_point now, Fn&& fn)
+{
+    if (now < m_start)
+    {
+        return 0;
+    }
+
+    auto nowTick{ static_cast<uint64_t>((now - m_start) / m_tick) };
+    if (nowTick < m_nextTick)
+    {
+        return 0;
+    }
+
+    // after a full round every slot has been visited once, further ticks would only revisit them
+    uint64_t lastTick{ std::min<uint64_t>(nowTick, m_nextTick + m_slots.size() - 1) };
+    m_firing.clear();
+    for (uint64_t tick{ m_nextTick }; tick <= lastTick; ++tick)
+    {
+        Collect(static_cast<size_t>(tick) & m_slotMask, nowTick);
+    }
+    m_nextTick = nowTick + 1;
+
+    size_t fired{ 0 };
+    for (auto id : m_firing)
+    {
+        // an earlier callback may have cancelled or rescheduled it
+        auto& entry{ m_entries[id] };
+        if (entry.state != EntryState::Firing)
+        {
+            continue;
+        }
+        entry.state = EntryState::Idle;
+        fn(id, entry.due);
+        ++fired;
+    }
+    return fired;
+}
+
+} // namespace rtp
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include "Common/ByteOrder.hpp"
+#include "Rtp/RtpHeader.hpp"
+
+namespace rtp
+{
+
+/**
+RFC 8285 header extension element
+
+One-Byte Header
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|       0xBE    |    0xDE       |           length=3            |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|  ID   | L=0   |     data      |  ID   |  L=1  |   data...
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+Two-Byte Header
+
+ 0                   1                   2                   3
+ 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|       0x10    |    0x00       |           length=3            |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|      ID       |     L=0       |     ID        |     L=1       |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|       data    |    0 (pad)    |       ID      |      L=4      |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+|                          data                                 |
++-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+struct RtpExtElement
+{
+    uint8_t id;
+    std::span<const uint8_t> data;
+};
+
+/**
+Iterates the elements of a one-byte or two-byte header extension block.
+
+Padding bytes are skipped. Iteration ends at the end of the block, at the one-byte form's reserved ID 15, or at the first
+element whose length runs past the block. Blocks with any other profile yield no elements.
+*/
+
+class RtpExtElements
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RtpExtElement;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const RtpExtElement*;
+        using reference = const RtpExtElement&;
+
+        Iterator() = default;
+
+        Iterator(std::span<const uint8_t> remaining, bool twoByte);
+
+        reference operator*() const { return m_current; }
+
+        pointer operator->() const { return &m_current; }
+
+        Iterator& operator++()
+        {
+            Next();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator prev{ *this };
+            Next();
+            return prev;
+        }
+
+        // only meaningful between iterators of the same extension block
+        bool operator==(const Iterator& other) const { return m_remaining.size() == other.m_remaining.size(); }
+
+    private:
+        void Next();
+
+        std::span<const uint8_t> m_remaining{};
+        size_t m_currentSize{ 0 };
+        bool m_twoByte{ false };
+        RtpExtElement m_current{};
+    };
+
+    RtpExtElements(uint16_t profile, std::span<const uint8_t> data);
+
+    Iterator begin() const { return Iterator{ m_data, m_twoByte }; }
+
+    Iterator end() const { return Iterator{}; }
+
+    // First element with the given id, if any
+    std::optional<std::span<const uint8_t>> Find(uint8_t id) const;
+
+private:
+    std::span<const uint8_t> m_data{};
+    bool m_twoByte{ false };
+};
+
+/**
+Non-owning view of a received RTP packet. Header fields are left in network byte order.
+*/
+
+struct RtpPacketView
+{
+    const RptHeader* header;
+    std::span<const uint8_t> csrcs;
+    uint16_t extProfile;
+    std::span<const uint8_t> extData;
+    std::span<const uint8_t> payload;
+    uint8_t paddingSize;
+
+    size_t CsrcCount() const { return csrcs.size() / sizeof(uint32_t); }
+
+    // host byte order
+    uint32_t Csrc(size_t idx) const { return LoadBe32(csrcs.data() + (idx * sizeof(uint32_t))); }
+
+    bool HasExtension() const { return header->ext != 0; }
+
+    RtpExtElements Extensions() const { return RtpExtElements{ extProfile, extData }; }
+};
+
+} // namespace rtp
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <endian.h>
+#include <span>
+#include <sys/uio.h>
+#include "Rtp/RtpPacketizer.hpp"
+#include "Rtp/RtpHeader.hpp"
+
+namespace rtp
+{
+
+void FillRtpHeader(RptHeader& header, uint8_t payloadType, bool marker, uint16_t seq, uint32_t ts, uint32_t ssrc)
+{
+    header.version = 2;
+    header.padding = 0;
+    header.ext = 0;
+    header.cc = 0;
+    header.marker = marker ? 1 : 0;
+    header.pktType = payloadType & 0x7F;
+    header.seq = htobe16(seq);
+    header.ts = htobe32(ts);
+    header.ssrc = htobe32(ssrc);
+}
+
+RtpPacketizer::RtpPacketizer(const RtpPacketizerConfig& config) :
+    m_headerPool(std::bit_ceil(std::max<size_t>(config.headerPoolSize, 1))),
+    m_poolMask{ m_headerPool.size() - 1 },
+    m_maxPayloadSize{ std::max<size_t>(config.mtu, sizeof(RptHeader) + 1) - sizeof(RptHeader) },
+    m_ssrc{ config.ssrc },
+    m_payloadType{ config.payloadType },
+    m_nextSeq{ config.initialSeq }
+{
+}
+
+size_t RtpPacketizer::PacketCount(size_t frameSize) const
+{
+    return (frameSize + m_maxPayloadSize - 1) / m_maxPayloadSize;
+}
+
+size_t RtpPacketizer::Packetize(std::span<const uint8_t> frame, uint32_t rtpTimestamp, std::span<RtpOutPacket> out)
+{
+    size_t nPkts{ PacketCount(frame.size()) };
+    if (nPkts == 0 || nPkts > out.size() || nPkts > m_headerPool.size())
+    {
+        return 0;
+    }
+
+    // spread evenly, the first (frame.size() % nPkts) packets carry one extra byte
+    size_t baseSize{ frame.size() / nPkts };
+    size_t nLarger{ frame.size() % nPkts };
+
+    size_t offset{ 0 };
+    for (size_t i{ 0 }; i < nPkts; ++i)
+    {
+        size_t payloadSize{ baseSize + (i < nLarger ? 1 : 0) };
+
+        auto& header{ NextHeaderSlot() };
+        FillRtpHeader(header, m_payloadType, (i + 1 == nPkts), m_nextSeq++, rtpTimestamp, m_ssrc);
+
+        out[i].iov[0] = iovec{ .iov_base = &header, .iov_len = sizeof(RptHeader) };
+        // iovec is not const-correct, the payload is only ever read
+        out[i].iov[1] = iovec{ .iov_base = const_cast<uint8_t*>(frame.data() + offset), .iov_len = payloadSize };
+
+        offset += payloadSize;
+    }
+
+    return nPkts;
+}
+
+RptHeader& RtpPacketizer::NextHeaderSlot()
+{
+    auto& slot{ m_headerPool[m_poolPos & m_poolMask] };
+    ++m_poolPos;
+    return slot;
+}
+
+} // namespace rtp
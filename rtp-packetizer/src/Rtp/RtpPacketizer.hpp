@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <sys/uio.h>
+#include <vector>
+#include "Rtp/RtpHeader.hpp"
+
+namespace rtp
+{
+
+/**
+Maps wall-clock capture times onto an RTP timestamp running at clockRate Hz, starting at initialTs for the first
+capture time seen.
+*/
+
+class RtpClock
+{
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    explicit RtpClock(uint32_t clockRate, uint32_t initialTs = 0) : m_clockRate{ clockRate }, m_initialTs{ initialTs } {}
+
+    uint32_t ToRtp(TimePoint captureTime)
+    {
+        if (!m_started)
+        {
+            m_epoch = captureTime;
+            m_started = true;
+        }
+
+        constexpr uint64_t nsPerSec{ 1'000'000'000 };
+        auto elapsed{
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(captureTime - m_epoch).count())
+        };
+        // split to keep the multiplication inside 64 bits
+        uint64_t ticks{ ((elapsed / nsPerSec) * m_clockRate) + (((elapsed % nsPerSec) * m_clockRate) / nsPerSec) };
+        // RTP timestamps wrap modulo 2^32
+        return m_initialTs + static_cast<uint32_t>(ticks);
+    }
+
+    uint32_t ClockRate() const { return m_clockRate; }
+
+private:
+    uint32_t m_clockRate;
+    uint32_t m_initialTs;
+    TimePoint m_epoch{};
+    bool m_started{ false };
+};
+
+// Fills a fixed header in network byte order, with no padding, extension or CSRCs
+void FillRtpHeader(RptHeader& header, uint8_t payloadType, bool marker, uint16_t seq, uint32_t ts, uint32_t ssrc);
+
+struct RtpPacketizerConfig
+{
+    size_t mtu{ 1200 };
+    uint32_t ssrc{ 0 };
+    uint8_t payloadType{ 96 };
+    uint16_t initialSeq{ 0 };
+    // number of reusable header slots, a power of two covering at least one sendmmsg batch
+    size_t headerPoolSize{ 64 };
+};
+
+// One outgoing packet as scatter-gather entries: [0] the RTP header, [1] the payload slice of the frame
+struct RtpOutPacket
+{
+    std::array<iovec, 2> iov;
+};
+
+/**
+Splits media frames into RTP packets without copying the payload.
+
+Each emitted packet points at a header slot from a fixed pool owned by the packetizer and at a slice of the caller's
+frame buffer, ready to be used as the msg_iov of an mmsghdr. Header slots are reused round robin, so a packet stays
+valid until headerPoolSize further packets have been emitted, and the frame buffer must outlive the send.
+*/
+
+class RtpPacketizer
+{
+public:
+    explicit RtpPacketizer(const RtpPacketizerConfig& config);
+
+    // Number of packets a frame of frameSize bytes is split into
+    size_t PacketCount(size_t frameSize) const;
+
+    // Splits frame into out, marking the last packet of the frame. Payload sizes are spread evenly over the packets.
+    // Returns the number of packets written, or 0 (without consuming sequence numbers) if out is too small, the frame
+    // is empty, or the frame needs more packets than the header pool holds.
+    size_t Packetize(std::span<const uint8_t> frame, uint32_t rtpTimestamp, std::span<RtpOutPacket> out);
+
+    uint16_t NextSeq() const { return m_nextSeq; }
+
+    size_t MaxPayloadSize() const { return m_maxPayloadSize; }
+
+private:
+    RptHeader& NextHeaderSlot();
+
+    std::vector<RptHeader> m_headerPool;
+    size_t m_poolMask;
+    size_t m_poolPos{ 0 };
+    size_t m_maxPayloadSize;
+    uint32_t m_ssrc;
+    uint8_t m_payloadType;
+    uint16_t m_nextSeq;
+};
+
+} // namespace rtp
@@ -0,0 +1,199 @@
+#include <cstddef>
+#include <cstdint>
+#include <endian.h>
+#include <optional>
+#include <span>
+#include "Rtp/RtpParser.hpp"
+#include "Rtp/RtpHeader.hpp"
+#include "Rtp/RtpPacketView.hpp"
+
+namespace rtp
+{
+
+std::optional<RtpPacketView> ParseRtp(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RptHeader))
+    {
+        return std::nullopt;
+    }
+
+    const auto* const header{ reinterpret_cast<const RptHeader*>(rawPkt.data()) };
+    if (header->version != 2)
+    {
+        return std::nullopt;
+    }
+
+    RtpPacketView pkt{};
+    pkt.header = header;
+
+    size_t offset{ sizeof(RptHeader) };
+    size_t csrcSize{ header->cc * sizeof(uint32_t) };
+    if (rawPkt.size() < offset + csrcSize)
+    {
+        return std::nullopt;
+    }
+
+    pkt.csrcs = rawPkt.subspan(offset, csrcSize);
+    offset += csrcSize;
+
+    if (header->ext != 0)
+    {
+        if (rawPkt.size() < offset + sizeof(RtpExtensionHeader))
+        {
+            return std::nullopt;
+        }
+
+        const auto* const extHeader{ reinterpret_cast<const RtpExtensionHeader*>(rawPkt.data() + offset) };
+        offset += sizeof(RtpExtensionHeader);
+
+        // length is in 32-bit words, excluding the extension header itself
+        size_t extSize{ static_cast<size_t>(be16toh(extHeader->length)) * sizeof(uint32_t) };
+        if (rawPkt.size() < offset + extSize)
+        {
+            return std::nullopt;
+        }
+
+        pkt.extProfile = be16toh(extHeader->profile);
+        pkt.extData = rawPkt.subspan(offset, extSize);
+        offset += extSize;
+    }
+
+    size_t payloadEnd{ rawPkt.size() };
+    if (header->padding != 0)
+    {
+        // rfc3550#section-5.1, the last octet counts the padding, itself included
+        uint8_t paddingSize{ rawPkt.back() };
+        if (paddingSize == 0 || paddingSize > (payloadEnd - offset))
+        {
+            return std::nullopt;
+        }
+
+        pkt.paddingSize = paddingSize;
+        payloadEnd -= paddingSize;
+    }
+
+    pkt.payload = rawPkt.subspan(offset, payloadEnd - offset);
+    return std::make_optional(pkt);
+}
+
+std::optional<size_t> RtpHeaderSize(std::span<const uint8_t> rawPkt)
+{
+    if (rawPkt.size() < sizeof(RptHeader))
+    {
+        return std::nullopt;
+    }
+
+    const auto* const header{ reinterpret_cast<const RptHeader*>(rawPkt.data()) };
+    if (header->version != 2)
+    {
+        return std::nullopt;
+    }
+
+    size_t size{ sizeof(RptHeader) + (header->cc * sizeof(uint32_t)) };
+    if (header->ext != 0)
+    {
+        if (rawPkt.size() < size + sizeof(RtpExtensionHeader))
+        {
+            return std::nullopt;
+        }
+
+        const auto* const extHeader{ reinterpret_cast<const RtpExtensionHeader*>(rawPkt.data() + size) };
+        size += sizeof(RtpExtensionHeader) + (static_cast<size_t>(be16toh(extHeader->length)) * sizeof(uint32_t));
+    }
+
+    if (rawPkt.size() < size)
+    {
+        return std::nullopt;
+    }
+    return size;
+}
+
+RtpExtElements::RtpExtElements(uint16_t profile, std::span<const uint8_t> data)
+{
+    if (profile == RtpExtProfile::OneByte)
+    {
+        m_data = data;
+    }
+    else if ((profile & 0xFFF0) == RtpExtProfile::TwoByte)
+    {
+        m_data = data;
+        m_twoByte = true;
+    }
+}
+
+std::optional<std::span<const uint8_t>> RtpExtElements::Find(uint8_t id) const
+{
+    for (const auto& element : *this)
+    {
+        if (element.id == id)
+        {
+            return element.data;
+        }
+    }
+
+    return std::nullopt;
+}
+
+RtpExtElements::Iterator::Iterator(std::span<const uint8_t> remaining, bool twoByte) :
+    m_remaining{ remaining },
+    m_twoByte{ twoByte }
+{
+    Next();
+}
+
+void RtpExtElements::Iterator::Next()
+{
+    m_remaining = m_remaining.subspan(m_currentSize);
+    m_currentSize = 0;
+
+    // padding
+    while (!m_remaining.empty() && m_remaining.front() == 0)
+    {
+        m_remaining = m_remaining.subspan(1);
+    }
+
+    if (m_remaining.empty())
+    {
+        return;
+    }
+
+    uint8_t id{};
+    size_t hdrSize{};
+    size_t dataSize{};
+    if (m_twoByte)
+    {
+        if (m_remaining.size() < 2)
+        {
+            m_remaining = {};
+            return;
+        }
+
+        id = m_remaining[0];
+        hdrSize = 2;
+        dataSize = m_remaining[1];
+    }
+    else
+    {
+        id = m_remaining[0] >> 4;
+        hdrSize = 1;
+        dataSize = static_cast<size_t>(m_remaining[0] & 0x0F) + 1;
+
+        // rfc8285#section-4.2, ID 15 is reserved and terminates processing
+        if (id == 15)
+        {
+            m_remaining = {};
+            return;
+        }
+    }
+
+    if (m_remaining.size() < hdrSize + dataSize)
+    {
+        m_remaining = {};
+        return;
+    }
+
+    m_current = RtpExtElement{ .id = id, .data = m_remaining.subspan(hdrSize, dataSize) };
+    m_currentSize = hdrSize + dataSize;
+}
+
+} // namespace rtp
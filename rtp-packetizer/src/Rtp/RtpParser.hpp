@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include "Rtp/RtpPacketView.hpp"
+
+namespace rtp
+{
+
+// Parses the fixed header, CSRC list, header extension and padding of an RTP packet without copying or allocating.
+// Returns std::nullopt when the packet is not version 2 or any of those sections runs past the buffer.
+std::optional<RtpPacketView> ParseRtp(std::span<const uint8_t> rawPkt);
+
+// Size of the fixed header, CSRC list and header extension, the part SRTP keeps in the clear. Unlike ParseRtp the
+// padding is not looked at, it is encrypted in an SRTP packet.
+std::optional<size_t> RtpHeaderSize(std::span<const uint8_t> rawPkt);
+
+} // namespace rtp
@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <endian.h>
+#include <optional>
+#include <span>
+#include "Rtp/RtpReceiverStats.hpp"
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtp/RtpPacketView.hpp"
+
+namespace rtp
+{
+
+namespace
+{
+
+// rfc3550#appendix-A.1
+constexpr uint32_t s_rtpSeqMod{ 1U << 16 };
+constexpr uint16_t s_maxDropout{ 3000 };
+constexpr uint16_t s_maxMisorder{ 100 };
+constexpr uint32_t s_minSequential{ 2 };
+
+void InitSeq(RtpSourceStats& stats, uint16_t seq)
+{
+    stats.baseSeq = seq;
+    stats.maxSeq = seq;
+    stats.badSeq = s_rtpSeqMod + 1;
+    stats.cycles = 0;
+    stats.received = 0;
+    stats.receivedPrior = 0;
+    stats.expectedPrior = 0;
+}
+
+// Returns false for packets that should not count, i.e. while on probation or after a large jump
+bool UpdateSeq(RtpSourceStats& stats, uint16_t seq)
+{
+    auto udelta{ static_cast<uint16_t>(seq - stats.maxSeq) };
+
+    if (stats.probation != 0)
+    {
+        // packet is in sequence
+        if (seq == static_cast<uint16_t>(stats.maxSeq + 1))
+        {
+            --stats.probation;
+            stats.maxSeq = seq;
+            if (stats.probation == 0)
+            {
+                InitSeq(stats, seq);
+                ++stats.received;
+                return true;
+            }
+        }
+        else
+        {
+            stats.probation = s_minSequential - 1;
+            stats.maxSeq = seq;
+        }
+        return false;
+    }
+
+    if (udelta < s_maxDropout)
+    {
+        // in order, with permissible gap
+        if (seq < stats.maxSeq)
+        {
+            // sequence number wrapped, count another 64K cycle
+            stats.cycles += s_rtpSeqMod;
+        }
+        stats.maxSeq = seq;
+    }
+    else if (udelta <= s_rtpSeqMod - s_maxMisorder)
+    {
+        // the sequence number made a very large jump
+        if (seq == stats.badSeq)
+        {
+            // two sequential packets, assume the other side restarted without telling us
+            InitSeq(stats, seq);
+        }
+        else
+        {
+            stats.badSeq = (seq + 1U) & (s_rtpSeqMod - 1);
+            return false;
+        }
+    }
+    // else duplicate or reordered packet
+
+    ++stats.received;
+    return true;
+}
+
+// murmur3 fmix32, SSRCs handed out by an SFU or a sequential allocator differ only in a few bits. A plain
+// multiplicative hash would leave the masked low bits depending on the low SSRC bits alone.
+constexpr size_t HashSsrc(uint32_t ssrc)
+{
+    ssrc ^= ssrc >> 16;
+    ssrc *= 0x85EBCA6BU;
+    ssrc ^= ssrc >> 13;
+    ssrc *= 0xC2B2AE35U;
+    ssrc ^= ssrc >> 16;
+    return static_cast<size_t>(ssrc);
+}
+
+} // namespace
+
+RtpReceiverStats::RtpReceiverStats(size_t maxSources, uint32_t clockRate) :
+    m_keys(std::bit_ceil(std::max<size_t>(((maxSources * 4) + 2) / 3, 2)), s_emptyKey),
+    m_stats(m_keys.size()),
+    m_mask{ m_keys.size() - 1 },
+    m_maxSize{ maxSources },
+    m_clockRate{ clockRate }
+{
+}
+
+size_t RtpReceiverStats::SlotOf(uint32_t ssrc) const { return HashSsrc(ssrc) & m_mask; }
+
+size_t RtpReceiverStats::FindSlot(uint32_t ssrc) const
+{
+    for (size_t slot{ SlotOf(ssrc) };; slot = (slot + 1) & m_mask)
+    {
+        if (m_keys[slot] == ssrc)
+        {
+            return slot;
+        }
+
+        if (m_keys[slot] == s_emptyKey)
+        {
+            return m_keys.size();
+        }
+    }
+}
+
+size_t RtpReceiverStats::FindOrInsert(uint32_t ssrc, uint16_t seq)
+{
+    size_t slot{ SlotOf(ssrc) };
+    for (;; slot = (slot + 1) & m_mask)
+    {
+        if (m_keys[slot] == ssrc)
+        {
+            return slot;
+        }
+
+        if (m_keys[slot] == s_emptyKey)
+        {
+            break;
+        }
+    }
+
+    if (m_size >= m_maxSize)
+    {
+        return m_keys.size();
+    }
+
+    m_keys[slot] = ssrc;
+    ++m_size;
+
+    // rfc3550#appendix-A.1, a new source starts on probation
+    auto& stats{ m_stats[slot] };
+    stats = RtpSourceStats{};
+    InitSeq(stats, seq);
+    stats.maxSeq = static_cast<uint16_t>(seq - 1);
+    stats.probation = s_minSequential;
+    return slot;
+}
+
+uint32_t RtpReceiverStats::ToRtpUnits(Clock::time_point time) const
+{
+    constexpr uint64_t nsPerSec{ 1'000'000'000 };
+    auto ns{ static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count()
+    ) };
+    // only differences matter, so wrapping modulo 2^32 is fine
+    return static_cast<uint32_t>(((ns / nsPerSec) * m_clockRate) + (((ns % nsPerSec) * m_clockRate) / nsPerSec));
+}
+
+bool RtpReceiverStats::OnRtp(uint32_t ssrc, uint16_t seq, uint32_t rtpTs, Clock::time_point arrival)
+{
+    size_t slot{ FindOrInsert(ssrc, seq) };
+    if (slot == m_keys.size())
+    {
+        return false;
+    }
+
+    auto& stats{ m_stats[slot] };
+    if (!UpdateSeq(stats, seq))
+    {
+        return true;
+    }
+
+    // rfc3550#appendix-A.8
+    uint32_t transit{ ToRtpUnits(arrival) - rtpTs };
+    if (stats.received > 1)
+    {
+        auto d{ static_cast<int32_t>(transit - stats.transit) };
+        auto absD{ static_cast<uint32_t>(d < 0 ? -d : d) };
+        stats.jitter += absD - ((stats.jitter + 8) >> 4);
+    }
+    stats.transit = transit;
+
+    return true;
+}
+
+bool RtpReceiverStats::OnRtp(const RtpPacketView& pkt, Clock::time_point arrival)
+{
+    return OnRtp(be32toh(pkt.header->ssrc), be16toh(pkt.header->seq), be32toh(pkt.header->ts), arrival);
+}
+
+void RtpReceiverStats::OnSenderReport(uint32_t ssrc, uint32_t ntpMsb, uint32_t ntpLsb, Clock::time_point arrival)
+{
+    size_t slot{ FindSlot(ssrc) };
+    if (slot == m_keys.size())
+    {
+        return;
+    }
+
+    auto& stats{ m_stats[slot] };
+    stats.lastSr = (ntpMsb << 16) | (ntpLsb >> 16);
+    stats.lastSrArrival = arrival;
+    stats.haveSr = true;
+}
+
+void RtpReceiverStats::OnSenderReport(const RtcpSenderReportView& sr, Clock::time_point arrival)
+{
+    OnSenderReport(
+        be32toh(sr.header->ssrc), be32toh(sr.header->ntpTimestampMsb), be32toh(sr.header->ntpTimestampLsb), arrival
+    );
+}
+
+RtcpReportBlock RtpReceiverStats::BuildReportBlock(uint32_t ssrc, RtpSourceStats& stats, Clock::time_point now)
+{
+    // rfc3550#appendix-A.3
+    uint32_t extendedMax{ stats.cycles + stats.maxSeq };
+    uint32_t expected{ extendedMax - stats.baseSeq + 1 };
+    auto lost{ static_cast<int64_t>(expected) - stats.received };
+    // 24-bit signed, clamped
+    lost = std::clamp<int64_t>(lost, -0x800000, 0x7FFFFF);
+
+    uint32_t expectedInterval{ expected - stats.expectedPrior };
+    uint32_t receivedInterval{ stats.received - stats.receivedPrior };
+    stats.expectedPrior = expected;
+    stats.receivedPrior = stats.received;
+
+    auto lostInterval{ static_cast<int64_t>(expectedInterval) - receivedInterval };
+    uint8_t fractionLost{ 0 };
+    if (expectedInterval != 0 && lostInterval > 0)
+    {
+        fractionLost = static_cast<uint8_t>((lostInterval << 8) / expectedInterval);
+    }
+
+    uint32_t delayLastSr{ 0 };
+    if (stats.haveSr)
+    {
+        // units of 1/65536 seconds
+        auto since{ std::chrono::duration_cast<std::chrono::microseconds>(now - stats.lastSrArrival).count() };
+        delayLastSr = static_cast<uint32_t>((static_cast<uint64_t>(std::max<int64_t>(since, 0)) << 16) / 1'000'000);
+    }
+
+    return RtcpReportBlock{
+        .ssrc = ssrc,
+        .fractionLost = fractionLost,
+        .cumNumPktsLost = static_cast<uint32_t>(lost) & 0xFFFFFF,
+        .extHighestSeqNumRx = extendedMax,
+        .intervalJitter = stats.jitter >> 4,
+        .lastSr = stats.haveSr ? stats.lastSr : 0,
+        .delayLastSr = delayLastSr,
+    };
+}
+
+std::optional<RtcpReportBlock> RtpReceiverStats::MakeReportBlock(uint32_t ssrc, Clock::time_point now)
+{
+    size_t slot{ FindSlot(ssrc) };
+    if (slot == m_keys.size() || m_stats[slot].probation != 0)
+    {
+        return std::nullopt;
+    }
+
+    return BuildReportBlock(ssrc, m_stats[slot], now);
+}
+
+size_t RtpReceiverStats::FillReportBlocks(Clock::time_point now, std::span<RtcpReportBlock> out)
+{
+    size_t nBlocks{ 0 };
+    for (size_t n{ 0 }; n < m_keys.size() && nBlocks < out.size(); ++n)
+    {
+        size_t slot{ m_reportCursor };
+        m_reportCursor = (m_reportCursor + 1) & m_mask;
+
+        if (m_keys[slot] == s_emptyKey)
+        {
+            continue;
+        }
+
+        auto& stats{ m_stats[slot] };
+        if (stats.probation != 0 || stats.received == stats.receivedPrior)
+        {
+            continue;
+        }
+
+        out[nBlocks++] = BuildReportBlock(static_cast<uint32_t>(m_keys[slot]), stats, now);
+    }
+
+    return nBlocks;
+}
+
+void RtpReceiverStats::Remove(uint32_t ssrc)
+{
+    size_t slot{ FindSlot(ssrc) };
+    if (slot == m_keys.size())
+    {
+        return;
+    }
+
+    // backward shift deletion keeps probe chains intact without tombstones
+    size_t hole{ slot };
+    for (size_t next{ (hole + 1) & m_mask }; m_keys[next] != s_emptyKey; next = (next + 1) & m_mask)
+    {
+        size_t home{ SlotOf(static_cast<uint32_t>(m_keys[next])) };
+        // move next into the hole unless its home lies cyclically in (hole, next]
+        if (((next - home) & m_mask) >= ((next - hole) & m_mask))
+        {
+            m_keys[hole] = m_keys[next];
+            m_stats[hole] = m_stats[next];
+            hole = next;
+        }
+    }
+
+    m_keys[hole] = s_emptyKey;
+    --m_size;
+}
+
+const RtpSourceStats* RtpReceiverStats::Find(uint32_t ssrc) const
+{
+    size_t slot{ FindSlot(ssrc) };
+    return slot == m_keys.size() ? nullptr : &m_stats[slot];
+}
+
+} // namespace rtp
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "Rtcp/RtcpHeader.hpp"
+#include "Rtcp/RtcpPacketViews.hpp"
+#include "Rtp/RtpPacketView.hpp"
+
+namespace rtp
+{
+
+/**
+RFC 3550 receiver statistics for one source, as maintained by the algorithms of appendix A.1, A.3 and A.8
+*/
+
+struct RtpSourceStats
+{
+    uint16_t maxSeq;
+    uint32_t cycles;
+    uint32_t baseSeq;
+    uint32_t badSeq;
+    uint32_t probation;
+    uint32_t received;
+    uint32_t expectedPrior;
+    uint32_t receivedPrior;
+    // relative transit time of the previous packet, in RTP timestamp units
+    uint32_t transit;
+    // interarrival jitter scaled by 16
+    uint32_t jitter;
+    // middle 32 bits of the NTP timestamp of the last SR
+    uint32_t lastSr;
+    std::chrono::steady_clock::time_point lastSrArrival;
+    bool haveSr;
+};
+
+/**
+Per-SSRC receiver statistics tracker producing ready-to-send report blocks.
+
+Sources live in a flat open-addressing table with linear probing over a key array, sized once at construction, so
+lookups touch one or two cache lines and neither packet updates nor new sources allocate. The table holds up to
+3/4 of its slot count, further sources are refused.
+*/
+
+class RtpReceiverStats
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RtpReceiverStats(size_t maxSources, uint32_t clockRate);
+
+    // Feeds one RTP arrival. Returns false if the source table is full.
+    bool OnRtp(uint32_t ssrc, uint16_t seq, uint32_t rtpTs, Clock::time_point arrival);
+
+    bool OnRtp(const RtpPacketView& pkt, Clock::time_point arrival);
+
+    // Records the LSR of a sender report from a known source
+    void OnSenderReport(uint32_t ssrc, uint32_t ntpMsb, uint32_t ntpLsb, Clock::time_point arrival);
+
+    void OnSenderReport(const RtcpSenderReportView& sr, Clock::time_point arrival);
+
+    // Report block for one source, std::nullopt if unknown or still on probation. Host byte order, ready for RtcpWriter.
+    std::optional<RtcpReportBlock> MakeReportBlock(uint32_t ssrc, Clock::time_point now);
+
+    // Fills out with blocks for sources heard from since their last report, resuming where the previous call stopped
+    // so more sources than fit in one report are rotated through. Returns the number of blocks written.
+    size_t FillReportBlocks(Clock::time_point now, std::span<RtcpReportBlock> out);
+
+    void Remove(uint32_t ssrc);
+
+    const RtpSourceStats* Find(uint32_t ssrc) const;
+
+    size_t Size() const { return m_size; }
+
+private:
+    static constexpr uint64_t s_emptyKey{ ~uint64_t{ 0 } };
+
+    size_t SlotOf(uint32_t ssrc) const;
+
+    // Existing or new slot for ssrc, or m_keys.size() if the table is full
+    size_t FindOrInsert(uint32_t ssrc, uint16_t seq);
+
+    size_t FindSlot(uint32_t ssrc) const;
+
+    RtcpReportBlock BuildReportBlock(uint32_t ssrc, RtpSourceStats& stats, Clock::time_point now);
+
+    uint32_t ToRtpUnits(Clock::time_point time) const;
+
+    std::vector<uint64_t> m_keys;
+    std::vector<RtpSourceStats> m_stats;
+    size_t m_mask;
+    size_t m_size{ 0 };
+    size_t m_maxSize;
+    size_t m_reportCursor{ 0 };
+    uint32_t m_clockRate;
+};
+
+} // namespace rtp
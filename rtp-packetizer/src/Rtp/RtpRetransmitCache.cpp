@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <sys/uio.h>
+#include <utility>
+#include "Rtp/RtpRetransmitCache.hpp"
+
+namespace rtp
+{
+
+RtpPacketRef::RtpPacketRef(const RtpPacketRef& other) : m_slab{ other.m_slab }, m_slot{ other.m_slot }
+{
+    if (m_slab != nullptr)
+    {
+        m_slab->AddRef(m_slot);
+    }
+}
+
+RtpPacketRef& RtpPacketRef::operator=(const RtpPacketRef& other)
+{
+    if (this != &other)
+    {
+        // take the new reference before dropping ours, both may name the same slot
+        if (other.m_slab != nullptr)
+        {
+            other.m_slab->AddRef(other.m_slot);
+        }
+        Reset();
+        m_slab = other.m_slab;
+        m_slot = other.m_slot;
+    }
+    return *this;
+}
+
+RtpPacketRef& RtpPacketRef::operator=(RtpPacketRef&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        m_slab = std::exchange(other.m_slab, nullptr);
+        m_slot = other.m_slot;
+    }
+    return *this;
+}
+
+void RtpPacketRef::Reset()
+{
+    if (m_slab != nullptr)
+    {
+        std::exchange(m_slab, nullptr)->Release(m_slot);
+    }
+}
+
+std::span<const uint8_t> RtpPacketRef::Data() const
+{
+    return m_slab != nullptr ? m_slab->SlotData(m_slot) : std::span<const uint8_t>{};
+}
+
+iovec RtpPacketRef::AsIovec() const
+{
+    auto data{ Data() };
+    return iovec{ .iov_base = const_cast<uint8_t*>(data.data()), .iov_len = data.size() };
+}
+
+RtpPacketSlab::RtpPacketSlab(size_t slotCount, size_t slotSize) :
+    m_storage(slotCount * slotSize),
+    m_refCounts(slotCount, 0),
+    m_sizes(slotCount, 0),
+    m_slotSize{ slotSize }
+{
+    // pop order hands out low slots first
+    m_free.reserve(slotCount);
+    for (size_t slot{ slotCount }; slot > 0; --slot)
+    {
+        m_free.push_back(static_cast<uint32_t>(slot - 1));
+    }
+}
+
+RtpPacketRef RtpPacketSlab::Store(std::span<const iovec> parts)
+{
+    size_t size{ 0 };
+    for (const auto& part : parts)
+    {
+        size += part.iov_len;
+    }
+
+    if (m_free.empty() || size > m_slotSize)
+    {
+        return {};
+    }
+
+    uint32_t slot{ m_free.back() };
+    m_free.pop_back();
+
+    uint8_t* dst{ m_storage.data() + (slot * m_slotSize) };
+    for (const auto& part : parts)
+    {
+        if (part.iov_len != 0)
+        {
+            std::memcpy(dst, part.iov_base, part.iov_len);
+            dst += part.iov_len;
+        }
+    }
+
+    m_sizes[slot] = static_cast<uint32_t>(size);
+    m_refCounts[slot] = 1;
+    return RtpPacketRef{ this, slot };
+}
+
+RtpPacketRef RtpPacketSlab::Store(std::span<const uint8_t> pkt)
+{
+    iovec part{ .iov_base = const_cast<uint8_t*>(pkt.data()), .iov_len = pkt.size() };
+    return Store({ &part, 1 });
+}
+
+RtpRetransmitHistory::RtpRetransmitHistory(const RtpRetransmitConfig& config) :
+    m_entries(std::bit_ceil(std::clamp<size_t>(config.capacity, 1, 0x8000))),
+    m_mask{ m_entries.size() - 1 },
+    m_maxAge{ config.maxAge },
+    m_maxBytes{ config.maxBytes }
+{
+}
+
+bool RtpRetransmitHistory::Insert(uint16_t seq, RtpPacketRef pkt, Clock::time_point sendTime)
+{
+    if (!pkt)
+    {
+        return false;
+    }
+
+    if (m_size == 0)
+    {
+        m_oldestSeq = seq;
+        m_nextSeq = seq;
+    }
+
+    // unsigned distances handle the 16-bit wraparound
+    if (static_cast<uint16_t>(seq - m_oldestSeq) < Span())
+    {
+        // late insert into a gap of the history
+        if (m_entries[seq & m_mask].pkt)
+        {
+            return false;
+        }
+    }
+    else if (static_cast<uint16_t>(seq - m_nextSeq) < m_entries.size())
+    {
+        // make room so the history spans at most capacity sequence numbers
+        while (m_size > 0 && static_cast<uint16_t>(seq - m_oldestSeq) >= m_entries.size())
+        {
+            EvictOldest();
+        }
+
+        if (m_size == 0)
+        {
+            m_oldestSeq = seq;
+        }
+        m_nextSeq = static_cast<uint16_t>(seq + 1);
+    }
+    else
+    {
+        // a sender restart or re-randomised sequence, nothing stored can be asked for any more
+        Clear();
+        m_oldestSeq = seq;
+        m_nextSeq = static_cast<uint16_t>(seq + 1);
+    }
+
+    m_bytes += pkt.Data().size();
+    ++m_size;
+    m_entries[seq & m_mask] = Entry{ .pkt = std::move(pkt), .sendTime = sendTime, .seq = seq };
+
+    // the packet just stored is kept even if it alone exceeds the budget
+    while (m_bytes > m_maxBytes && m_size > 1)
+    {
+        EvictOldest();
+    }
+    EvictExpired(sendTime);
+
+    return true;
+}
+
+const RtpPacketRef* RtpRetransmitHistory::Find(uint16_t seq) const
+{
+    if (m_size == 0 || static_cast<uint16_t>(seq - m_oldestSeq) >= Span())
+    {
+        return nullptr;
+    }
+
+    const auto& entry{ m_entries[seq & m_mask] };
+    return entry.pkt && entry.seq == seq ? &entry.pkt : nullptr;
+}
+
+void RtpRetransmitHistory::EvictExpired(Clock::time_point now)
+{
+    while (m_size > 0)
+    {
+        // holes left by the sender are skipped by EvictOldest, look at the first stored packet
+        while (!m_entries[m_oldestSeq & m_mask].pkt)
+        {
+            ++m_oldestSeq;
+        }
+
+        if (now - m_entries[m_oldestSeq & m_mask].sendTime <= m_maxAge)
+        {
+            return;
+        }
+        EvictOldest();
+    }
+}
+
+void RtpRetransmitHistory::Clear()
+{
+    for (auto& entry : m_entries)
+    {
+        entry.pkt.Reset();
+    }
+    m_size = 0;
+    m_bytes = 0;
+    m_oldestSeq = m_nextSeq;
+}
+
+void RtpRetransmitHistory::EvictOldest()
+{
+    // only called with m_size > 0, so a stored packet lies within the span
+    while (!m_entries[m_oldestSeq & m_mask].pkt)
+    {
+        ++m_oldestSeq;
+    }
+
+    auto& entry{ m_entries[m_oldestSeq & m_mask] };
+    m_bytes -= entry.pkt.Data().size();
+    entry.pkt.Reset();
+    --m_size;
+    ++m_oldestSeq;
+
+    if (m_size == 0)
+    {
+        m_oldestSeq = m_nextSeq;
+    }
+}
+
+} // namespace rtp
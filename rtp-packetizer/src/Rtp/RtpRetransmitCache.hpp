@@ -0,0 +1,201 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <sys/uio.h>
+#include <utility>
+#include <vector>
+#include "Rtcp/RtcpNackSet.hpp"
+
+namespace rtp
+{
+
+class RtpPacketSlab;
+
+/**
+Refcounted handle to one packet stored in an RtpPacketSlab.
+
+Copying a handle only bumps the refcount, the slot goes back to the slab when the last handle to it is dropped. A
+default constructed handle holds nothing. Handles must not outlive their slab.
+*/
+
+class RtpPacketRef
+{
+public:
+    RtpPacketRef() = default;
+
+    RtpPacketRef(const RtpPacketRef& other);
+
+    RtpPacketRef(RtpPacketRef&& other) noexcept :
+        m_slab{ std::exchange(other.m_slab, nullptr) },
+        m_slot{ other.m_slot }
+    {
+    }
+
+    RtpPacketRef& operator=(const RtpPacketRef& other);
+
+    RtpPacketRef& operator=(RtpPacketRef&& other) noexcept;
+
+    ~RtpPacketRef() { Reset(); }
+
+    void Reset();
+
+    explicit operator bool() const { return m_slab != nullptr; }
+
+    // Stored bytes, empty for an empty handle
+    std::span<const uint8_t> Data() const;
+
+    // Ready to be used as one msg_iov entry for a resend
+    iovec AsIovec() const;
+
+private:
+    friend class RtpPacketSlab;
+
+    RtpPacketRef(RtpPacketSlab* slab, uint32_t slot) : m_slab{ slab }, m_slot{ slot } {}
+
+    RtpPacketSlab* m_slab{ nullptr };
+    uint32_t m_slot{ 0 };
+};
+
+/**
+Fixed-size slab of packet slots, sized once at construction.
+
+Each stored packet is copied in exactly once, into a slot of slotSize bytes, and is then shared through RtpPacketRef.
+Slots are recycled through a free list, so storing never allocates. Not thread safe, a slab and its handles belong to
+one sending thread.
+*/
+
+class RtpPacketSlab
+{
+public:
+    RtpPacketSlab(size_t slotCount, size_t slotSize = 1500);
+
+    RtpPacketSlab(const RtpPacketSlab&) = delete;
+    RtpPacketSlab& operator=(const RtpPacketSlab&) = delete;
+    RtpPacketSlab(RtpPacketSlab&&) = delete;
+    RtpPacketSlab& operator=(RtpPacketSlab&&) = delete;
+
+    // Gathers the parts into a free slot. Empty handle if the slab is exhausted or the parts exceed the slot size.
+    RtpPacketRef Store(std::span<const iovec> parts);
+
+    RtpPacketRef Store(std::span<const uint8_t> pkt);
+
+    size_t SlotSize() const { return m_slotSize; }
+
+    size_t FreeSlots() const { return m_free.size(); }
+
+    size_t SlotCount() const { return m_refCounts.size(); }
+
+private:
+    friend class RtpPacketRef;
+
+    void AddRef(uint32_t slot) { ++m_refCounts[slot]; }
+
+    void Release(uint32_t slot)
+    {
+        if (--m_refCounts[slot] == 0)
+        {
+            m_free.push_back(slot);
+        }
+    }
+
+    std::span<const uint8_t> SlotData(uint32_t slot) const
+    {
+        return { m_storage.data() + (slot * m_slotSize), m_sizes[slot] };
+    }
+
+    std::vector<uint8_t> m_storage;
+    std::vector<uint32_t> m_refCounts;
+    std::vector<uint32_t> m_sizes;
+    std::vector<uint32_t> m_free;
+    size_t m_slotSize;
+};
+
+struct RtpRetransmitConfig
+{
+    // sequence numbers covered, rounded up to a power of two, at most half the sequence number space
+    size_t capacity{ 1024 };
+    // packets sent longer ago than this are dropped
+    std::chrono::steady_clock::duration maxAge{ std::chrono::seconds{ 1 } };
+    // total stored bytes of the stream, the oldest packets are dropped past it
+    size_t maxBytes{ 1 << 20 };
+};
+
+/**
+History of recently sent packets of one RTP stream (one SSRC), for answering NACKs.
+
+Entries sit in a ring indexed by sequence number, so a lookup is one slot read and a wraparound-safe compare. The
+history spans at most capacity sequence numbers, and the oldest packets are evicted first once they exceed maxAge or
+the stream exceeds maxBytes. Packet bytes live in a shared RtpPacketSlab, the history only holds handles, so a resend
+references the stored bytes instead of copying them.
+*/
+
+class RtpRetransmitHistory
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RtpRetransmitHistory(const RtpRetransmitConfig& config);
+
+    // Records a sent packet. Returns false for an empty handle or a sequence number that is already stored. A sequence
+    // number neither inside the history nor less than capacity ahead of it, in either direction, restarts the history
+    // at seq.
+    bool Insert(uint16_t seq, RtpPacketRef pkt, Clock::time_point sendTime);
+
+    // Stored packet for seq, nullptr if it was never stored or has been evicted
+    const RtpPacketRef* Find(uint16_t seq) const;
+
+    // fn(seq, const RtpPacketRef&) for every NACKed sequence number still in the history. Returns the number found.
+    template<typename Fn>
+    size_t ForEachLost(const RtcpNackSet& lost, Fn&& fn) const
+    {
+        size_t found{ 0 };
+        lost.ForEach(
+            [&](uint16_t seq)
+            {
+                if (const auto* pkt{ Find(seq) })
+                {
+                    fn(seq, *pkt);
+                    ++found;
+                }
+            }
+        );
+        return found;
+    }
+
+    // Drops packets sent more than maxAge before now
+    void EvictExpired(Clock::time_point now);
+
+    void Clear();
+
+    size_t Size() const { return m_size; }
+
+    size_t Bytes() const { return m_bytes; }
+
+private:
+    struct Entry
+    {
+        RtpPacketRef pkt;
+        Clock::time_point sendTime;
+        uint16_t seq;
+    };
+
+    // Sequence numbers between the oldest stored packet and the newest
+    uint16_t Span() const { return static_cast<uint16_t>(m_nextSeq - m_oldestSeq); }
+
+    void EvictOldest();
+
+    std::vector<Entry> m_entries;
+    size_t m_mask;
+    Clock::duration m_maxAge;
+    size_t m_maxBytes;
+    size_t m_size{ 0 };
+    size_t m_bytes{ 0 };
+    uint16_t m_oldestSeq{ 0 };
+    // one past the newest stored sequence number
+    uint16_t m_nextSeq{ 0 };
+};
+
+} // namespace rtp
@@ -0,0 +1,856 @@
+#include "Srtp/SrtpSession.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <endian.h>
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <optional>
+#include <span>
+#include <utility>
+#include "Common/ByteOrder.hpp"
+#include "Rtp/RtpHeader.hpp"
+#include "Rtp/RtpParser.hpp"
+
+namespace rtp
+{
+
+namespace
+{
+
+// rfc3711#section-4.3.2, the RTCP labels are these plus 3
+constexpr uint8_t s_labelEncryption{ 0 };
+constexpr uint8_t s_labelAuth{ 1 };
+constexpr uint8_t s_labelSalt{ 2 };
+constexpr uint8_t s_labelRtcpOffset{ 3 };
+
+constexpr size_t s_aesBlockSize{ 16 };
+constexpr size_t s_authKeySize{ 20 };
+constexpr size_t s_hmacSha1Size{ 20 };
+constexpr size_t s_gcmIvSize{ 12 };
+
+// header and sender SSRC stay in the clear in SRTCP
+constexpr size_t s_srtcpClearSize{ 8 };
+constexpr uint32_t s_srtcpEncryptedFlag{ 0x80000000 };
+constexpr uint32_t s_srtcpIndexMask{ 0x7FFFFFFF };
+
+// rfc3711#section-4.3.3 AES-CM PRF with key derivation rate 0: the keystream of IV (salt ^ label) * 2^16
+bool DeriveSessionKey(
+    std::span<const uint8_t> masterKey, const std::array<uint8_t, 14>& masterSalt, uint8_t label, std::span<uint8_t> out
+)
+{
+    std::array<uint8_t, s_aesBlockSize> iv{};
+    std::copy(masterSalt.begin(), masterSalt.end(), iv.begin());
+    // label sits right above the 48 bit index, i.e. in the 8th of the 14 salt bytes
+    iv[7] ^= label;
+
+    std::fill(out.begin(), out.end(), uint8_t{ 0 });
+    auto* ctx{ EVP_CIPHER_CTX_new() };
+    int outLen{};
+    bool ok{ ctx != nullptr && EVP_EncryptInit_ex(ctx, EVP_aes_128_ctr(), nullptr, masterKey.data(), iv.data()) == 1 &&
+             EVP_EncryptUpdate(ctx, out.data(), &outLen, out.data(), static_cast<int>(out.size())) == 1 };
+    EVP_CIPHER_CTX_free(ctx);
+    return ok;
+}
+
+// rfc3711#appendix-A, the index closest to the highest one seen so far
+uint64_t EstimateIndex(uint64_t maxIndex, uint16_t seq)
+{
+    auto roc{ static_cast<uint32_t>(maxIndex >> 16) };
+    auto lastSeq{ static_cast<uint16_t>(maxIndex) };
+
+    uint32_t guess{ roc };
+    if (lastSeq < 0x8000)
+    {
+        if (seq > lastSeq && seq - lastSeq > 0x8000 && roc > 0)
+        {
+            guess = roc - 1;
+        }
+    }
+    else if (seq < lastSeq - 0x8000)
+    {
+        guess = roc + 1;
+    }
+
+    return (static_cast<uint64_t>(guess) << 16) | seq;
+}
+
+void XorBe32(uint8_t* dst, uint32_t val)
+{
+    std::array<uint8_t, sizeof(uint32_t)> bytes{};
+    StoreBe32(bytes.data(), val);
+    for (size_t i{ 0 }; i < bytes.size(); ++i)
+    {
+        dst[i] ^= bytes[i];
+    }
+}
+
+// rfc3711#section-4.1.1, (salt * 2^16) ^ (SSRC * 2^64) ^ (index * 2^16), the low 16 bits left for the block counter
+std::array<uint8_t, s_aesBlockSize> CmIv(const std::array<uint8_t, 14>& salt, uint32_t ssrc, uint64_t index)
+{
+    std::array<uint8_t, s_aesBlockSize> iv{};
+    std::copy(salt.begin(), salt.end(), iv.begin());
+    XorBe32(iv.data() + 4, ssrc);
+    XorBe32(iv.data() + 8, static_cast<uint32_t>(index >> 16));
+    iv[12] ^= static_cast<uint8_t>(index >> 8);
+    iv[13] ^= static_cast<uint8_t>(index);
+    return iv;
+}
+
+/**
+rfc7714#section-8.1 and rfc7714#section-9.1 IVs, XORed with the 12 byte salt
+
+  0  1  2  3  4  5  6  7  8  9 10 11
++--+--+--+--+--+--+--+--+--+--+--+--+
+|00|00|    SSRC   |     ROC   | SEQ |  SRTP
++--+--+--+--+--+--+--+--+--+--+--+--+
+|00|00|    SSRC   |00|00|0+SRTCP idx|  SRTCP
++--+--+--+--+--+--+--+--+--+--+--+--+
+*/
+
+std::array<uint8_t, s_gcmIvSize> GcmIv(const std::array<uint8_t, 14>& salt, uint32_t ssrc, uint64_t index)
+{
+    std::array<uint8_t, s_gcmIvSize> iv{};
+    std::copy(salt.begin(), salt.begin() + s_gcmIvSize, iv.begin());
+    XorBe32(iv.data() + 2, ssrc);
+    // 48 bit ROC and SEQ, or the SRTCP index with zeros above it
+    XorBe32(iv.data() + 6, static_cast<uint32_t>(index >> 16));
+    iv[10] ^= static_cast<uint8_t>(index >> 8);
+    iv[11] ^= static_cast<uint8_t>(index);
+    return iv;
+}
+
+// The packet must be at least a fixed RTP header, already checked by RtpHeaderSize
+std::pair<uint32_t, uint16_t> RtpSsrcSeq(std::span<const uint8_t> pkt)
+{
+    const auto* const header{ reinterpret_cast<const RptHeader*>(pkt.data()) };
+    return { be32toh(header->ssrc), be16toh(header->seq) };
+}
+
+} // namespace
+
+void SrtpSession::CipherCtxFree::operator()(EVP_CIPHER_CTX* ctx) const
+{
+    EVP_CIPHER_CTX_free(ctx);
+}
+
+void SrtpSession::MacCtxFree::operator()(EVP_MAC_CTX* ctx) const
+{
+    EVP_MAC_CTX_free(ctx);
+}
+
+std::optional<SrtpSession> SrtpSession::Create(
+    SrtpProfile profile, std::span<const uint8_t> masterKey, std::span<const uint8_t> masterSalt
+)
+{
+    if (masterKey.size() != s_srtpMasterKeySize || masterSalt.size() != SrtpMasterSaltSize(profile))
+    {
+        return std::nullopt;
+    }
+
+    // the PRF takes a 112 bit salt, the 96 bit AES-GCM one is zero padded on the right, rfc7714#section-11
+    std::array<uint8_t, 14> salt{};
+    std::copy(masterSalt.begin(), masterSalt.end(), salt.begin());
+
+    auto rtpKeys{ DeriveKeys(profile, masterKey, salt, s_labelEncryption) };
+    auto rtcpKeys{ DeriveKeys(profile, masterKey, salt, s_labelEncryption + s_labelRtcpOffset) };
+    if (!rtpKeys || !rtcpKeys)
+    {
+        return std::nullopt;
+    }
+
+    return SrtpSession{ profile, std::move(*rtpKeys), std::move(*rtcpKeys) };
+}
+
+SrtpSession::SrtpSession(SrtpProfile profile, SrtpKeys rtpKeys, SrtpKeys rtcpKeys) :
+    m_profile{ profile },
+    m_rtpKeys{ std::move(rtpKeys) },
+    m_rtcpKeys{ std::move(rtcpKeys) }
+{
+}
+
+std::optional<SrtpSession::SrtpKeys> SrtpSession::DeriveKeys(
+    SrtpProfile profile,
+    std::span<const uint8_t> masterKey,
+    const std::array<uint8_t, 14>& masterSalt,
+    uint8_t encryptionLabel
+)
+{
+    bool gcm{ profile == SrtpProfile::AeadAes128Gcm };
+    uint8_t kind{ static_cast<uint8_t>(encryptionLabel - s_labelEncryption) };
+
+    SrtpKeys keys{};
+    std::array<uint8_t, s_srtpMasterKeySize> encKey{};
+    std::array<uint8_t, s_authKeySize> authKey{};
+
+    bool ok{ DeriveSessionKey(masterKey, masterSalt, encryptionLabel, encKey) &&
+             DeriveSessionKey(
+                 masterKey, masterSalt, kind + s_labelSalt, std::span{ keys.salt }.first(SrtpMasterSaltSize(profile))
+             ) };
+
+    keys.cipher.reset(EVP_CIPHER_CTX_new());
+    ok = ok && keys.cipher != nullptr &&
+         EVP_EncryptInit_ex(
+             keys.cipher.get(), gcm ? EVP_aes_128_gcm() : EVP_aes_128_ecb(), nullptr, encKey.data(), nullptr
+         ) == 1;
+    if (ok && !gcm)
+    {
+        // whole counter blocks only
+        EVP_CIPHER_CTX_set_padding(keys.cipher.get(), 0);
+
+        ok = DeriveSessionKey(masterKey, masterSalt, kind + s_labelAuth, authKey);
+
+        EVP_MAC* hmac{ EVP_MAC_fetch(nullptr, OSSL_MAC_NAME_HMAC, nullptr) };
+        keys.mac.reset(hmac != nullptr ? EVP_MAC_CTX_new(hmac) : nullptr);
+        EVP_MAC_free(hmac);
+
+        std::array<OSSL_PARAM, 2> params{
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA1"), 0),
+            OSSL_PARAM_construct_end(),
+        };
+        ok = ok && keys.mac != nullptr &&
+             EVP_MAC_init(keys.mac.get(), authKey.data(), authKey.size(), params.data()) == 1;
+    }
+
+    OPENSSL_cleanse(encKey.data(), encKey.size());
+    OPENSSL_cleanse(authKey.data(), authKey.size());
+    if (!ok)
+    {
+        return std::nullopt;
+    }
+    return std::make_optional(std::move(keys));
+}
+
+const SrtpSession::SrtpStream* SrtpSession::RxStream(uint32_t ssrc) const
+{
+    auto it{ m_streams.find(ssrc) };
+    return it != m_streams.end() ? &it->second : nullptr;
+}
+
+size_t SrtpSession::QueueCounterBlocks(const std::array<uint8_t, 16>& iv, size_t size)
+{
+    size_t ksOffset{ m_keystream.size() };
+    size_t nBlocks{ (size + s_aesBlockSize - 1) / s_aesBlockSize };
+    m_keystream.resize(ksOffset + (nBlocks * s_aesBlockSize));
+
+    uint8_t* block{ m_keystream.data() + ksOffset };
+    for (size_t i{ 0 }; i < nBlocks; ++i, block += s_aesBlockSize)
+    {
+        std::memcpy(block, iv.data(), s_aesBlockSize);
+        StoreBe16(block + 14, static_cast<uint16_t>(i));
+    }
+    return ksOffset;
+}
+
+bool SrtpSession::RunKeystream(SrtpKeys& keys)
+{
+    if (m_keystream.empty())
+    {
+        return true;
+    }
+
+    int outLen{};
+    return EVP_EncryptUpdate(
+               keys.cipher.get(), m_keystream.data(), &outLen, m_keystream.data(), static_cast<int>(m_keystream.size())
+           ) == 1;
+}
+
+void SrtpSession::XorKeystream(std::span<uint8_t> data, size_t ksOffset) const
+{
+    const uint8_t* ks{ m_keystream.data() + ksOffset };
+    size_t i{ 0 };
+    for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t))
+    {
+        uint64_t word{};
+        uint64_t ksWord{};
+        std::memcpy(&word, data.data() + i, sizeof(word));
+        std::memcpy(&ksWord, ks + i, sizeof(ksWord));
+        word ^= ksWord;
+        std::memcpy(data.data() + i, &word, sizeof(word));
+    }
+    for (; i < data.size(); ++i)
+    {
+        data[i] ^= ks[i];
+    }
+}
+
+bool SrtpSession::CmTag(
+    SrtpKeys& keys, std::span<const uint8_t> authPortion, std::span<const uint8_t> authTail, uint8_t* tag
+) const
+{
+    // re-initialising without a key restarts from the precomputed inner and outer pads
+    auto* ctx{ keys.mac.get() };
+    std::array<uint8_t, s_hmacSha1Size> mac{};
+    size_t macLen{};
+    if (EVP_MAC_init(ctx, nullptr, 0, nullptr) != 1 ||
+        EVP_MAC_update(ctx, authPortion.data(), authPortion.size()) != 1 ||
+        (!authTail.empty() && EVP_MAC_update(ctx, authTail.data(), authTail.size()) != 1) ||
+        EVP_MAC_final(ctx, mac.data(), &macLen, mac.size()) != 1)
+    {
+        return false;
+    }
+
+    std::memcpy(tag, mac.data(), SrtpTagSize(m_profile));
+    return true;
+}
+
+bool SrtpSession::GcmSeal(
+    SrtpKeys& keys,
+    const std::array<uint8_t, 12>& iv,
+    std::span<const uint8_t> aad,
+    std::span<const uint8_t> aadTail,
+    std::span<uint8_t> data,
+    uint8_t* tag
+)
+{
+    auto* ctx{ keys.cipher.get() };
+    int outLen{};
+    std::array<uint8_t, s_aesBlockSize> finalOut{};
+    return EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, iv.data(), 1) == 1 &&
+           EVP_CipherUpdate(ctx, nullptr, &outLen, aad.data(), static_cast<int>(aad.size())) == 1 &&
+           (aadTail.empty() ||
+            EVP_CipherUpdate(ctx, nullptr, &outLen, aadTail.data(), static_cast<int>(aadTail.size())) == 1) &&
+           (data.empty() ||
+            EVP_CipherUpdate(ctx, data.data(), &outLen, data.data(), static_cast<int>(data.size())) == 1) &&
+           EVP_CipherFinal_ex(ctx, finalOut.data(), &outLen) == 1 &&
+           EVP_CIPHER_CTX_ctrl(
+               ctx, EVP_CTRL_AEAD_GET_TAG, static_cast<int>(SrtpTagSize(SrtpProfile::AeadAes128Gcm)), tag
+           ) == 1;
+}
+
+bool SrtpSession::GcmOpen(
+    SrtpKeys& keys,
+    const std::array<uint8_t, 12>& iv,
+    std::span<const uint8_t> aad,
+    std::span<const uint8_t> aadTail,
+    std::span<uint8_t> data,
+    const uint8_t* tag
+)
+{
+    auto* ctx{ keys.cipher.get() };
+    int outLen{};
+    std::array<uint8_t, s_aesBlockSize> finalOut{};
+    return EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, iv.data(), 0) == 1 &&
+           EVP_CipherUpdate(ctx, nullptr, &outLen, aad.data(), static_cast<int>(aad.size())) == 1 &&
+           (aadTail.empty() ||
+            EVP_CipherUpdate(ctx, nullptr, &outLen, aadTail.data(), static_cast<int>(aadTail.size())) == 1) &&
+           (data.empty() ||
+            EVP_CipherUpdate(ctx, data.data(), &outLen, data.data(), static_cast<int>(data.size())) == 1) &&
+           EVP_CIPHER_CTX_ctrl(
+               ctx,
+               EVP_CTRL_AEAD_SET_TAG,
+               static_cast<int>(SrtpTagSize(SrtpProfile::AeadAes128Gcm)),
+               const_cast<uint8_t*>(tag)
+           ) == 1 &&
+           EVP_CipherFinal_ex(ctx, finalOut.data(), &outLen) == 1;
+}
+
+SrtpStatus SrtpSession::ProtectRtp(std::span<uint8_t> buffer, size_t& size)
+{
+    SrtpPacket pkt{ buffer, size };
+    ProtectRtp(std::span{ &pkt, 1 });
+    size = pkt.size;
+    return pkt.status;
+}
+
+SrtpStatus SrtpSession::UnprotectRtp(std::span<uint8_t> buffer, size_t& size)
+{
+    SrtpPacket pkt{ buffer, size };
+    UnprotectRtp(std::span{ &pkt, 1 });
+    size = pkt.size;
+    return pkt.status;
+}
+
+SrtpStatus SrtpSession::ProtectRtcp(std::span<uint8_t> buffer, size_t& size)
+{
+    SrtpPacket pkt{ buffer, size };
+    ProtectRtcp(std::span{ &pkt, 1 });
+    size = pkt.size;
+    return pkt.status;
+}
+
+SrtpStatus SrtpSession::UnprotectRtcp(std::span<uint8_t> buffer, size_t& size)
+{
+    SrtpPacket pkt{ buffer, size };
+    UnprotectRtcp(std::span{ &pkt, 1 });
+    size = pkt.size;
+    return pkt.status;
+}
+
+size_t SrtpSession::ProtectRtp(std::span<SrtpPacket> pkts)
+{
+    return m_profile == SrtpProfile::AeadAes128Gcm ? ProtectRtpGcm(pkts) : ProtectRtpCm(pkts);
+}
+
+size_t SrtpSession::UnprotectRtp(std::span<SrtpPacket> pkts)
+{
+    return m_profile == SrtpProfile::AeadAes128Gcm ? UnprotectRtpGcm(pkts) : UnprotectRtpCm(pkts);
+}
+
+size_t SrtpSession::ProtectRtcp(std::span<SrtpPacket> pkts)
+{
+    return m_profile == SrtpProfile::AeadAes128Gcm ? ProtectRtcpGcm(pkts) : ProtectRtcpCm(pkts);
+}
+
+size_t SrtpSession::UnprotectRtcp(std::span<SrtpPacket> pkts)
+{
+    return m_profile == SrtpProfile::AeadAes128Gcm ? UnprotectRtcpGcm(pkts) : UnprotectRtcpCm(pkts);
+}
+
+namespace
+{
+
+// Next RTP index of a sender, following the sequence number across wraps
+uint64_t NextTxIndex(uint64_t& txIndex, bool& started, uint16_t seq)
+{
+    uint64_t index{ started ? EstimateIndex(txIndex, seq) : seq };
+    if (!started || index > txIndex)
+    {
+        txIndex = index;
+        started = true;
+    }
+    return index;
+}
+
+size_t CountOk(std::span<const SrtpPacket> pkts)
+{
+    return static_cast<size_t>(
+        std::count_if(pkts.begin(), pkts.end(), [](const SrtpPacket& pkt) { return pkt.status == SrtpStatus::Ok; })
+    );
+}
+
+} // namespace
+
+size_t SrtpSession::ProtectRtpCm(std::span<SrtpPacket> pkts)
+{
+    size_t tagSize{ SrtpTagSize(m_profile) };
+    m_keystream.clear();
+    m_jobs.clear();
+
+    // first pass: indices and counter blocks of every packet
+    for (size_t i{ 0 }; i < pkts.size(); ++i)
+    {
+        auto& pkt{ pkts[i] };
+        auto headerSize{ pkt.size <= pkt.buffer.size() ? RtpHeaderSize(pkt.buffer.first(pkt.size)) : std::nullopt };
+        if (!headerSize)
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+        if (pkt.buffer.size() - pkt.size < tagSize)
+        {
+            pkt.status = SrtpStatus::NoRoom;
+            continue;
+        }
+
+        auto [ssrc, seq]{ RtpSsrcSeq(pkt.buffer) };
+        auto& stream{ TxStream(ssrc) };
+        uint64_t index{ NextTxIndex(stream.rtpTxIndex, stream.rtpTxStarted, seq) };
+
+        size_t cipherSize{ pkt.size - *headerSize };
+        size_t ksOffset{ QueueCounterBlocks(CmIv(m_rtpKeys.salt, ssrc, index), cipherSize) };
+        m_jobs.push_back(CmJob{ i, *headerSize, cipherSize, ksOffset, index });
+        pkt.status = SrtpStatus::Ok;
+    }
+
+    bool keystreamOk{ RunKeystream(m_rtpKeys) };
+
+    // second pass: encrypt, then authenticate header, ciphertext and ROC
+    for (const auto& job : m_jobs)
+    {
+        auto& pkt{ pkts[job.pktIdx] };
+        if (!keystreamOk)
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+
+        XorKeystream(pkt.buffer.subspan(job.cipherOffset, job.cipherSize), job.ksOffset);
+
+        std::array<uint8_t, sizeof(uint32_t)> roc{};
+        StoreBe32(roc.data(), static_cast<uint32_t>(job.index >> 16));
+        if (!CmTag(m_rtpKeys, pkt.buffer.first(pkt.size), roc, pkt.buffer.data() + pkt.size))
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+        pkt.size += tagSize;
+    }
+
+    return CountOk(pkts);
+}
+
+size_t SrtpSession::UnprotectRtpCm(std::span<SrtpPacket> pkts)
+{
+    size_t tagSize{ SrtpTagSize(m_profile) };
+    m_keystream.clear();
+    m_jobs.clear();
+
+    // first pass: authenticate before touching the payload, queue counter blocks of the packets that passed
+    for (size_t i{ 0 }; i < pkts.size(); ++i)
+    {
+        auto& pkt{ pkts[i] };
+        if (pkt.size > pkt.buffer.size() || pkt.size < tagSize)
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+
+        auto authPortion{ pkt.buffer.first(pkt.size - tagSize) };
+        auto headerSize{ RtpHeaderSize(authPortion) };
+        if (!headerSize)
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+
+        auto [ssrc, seq]{ RtpSsrcSeq(authPortion) };
+        const auto* stream{ RxStream(ssrc) };
+        uint64_t index{ stream != nullptr ? EstimateIndex(stream->rtpRx.MaxIndex(), seq) : seq };
+        if (stream != nullptr && !stream->rtpRx.Check(index))
+        {
+            pkt.status = SrtpStatus::Replayed;
+            continue;
+        }
+
+        std::array<uint8_t, sizeof(uint32_t)> roc{};
+        StoreBe32(roc.data(), static_cast<uint32_t>(index >> 16));
+        std::array<uint8_t, s_hmacSha1Size> tag{};
+        if (!CmTag(m_rtpKeys, authPortion, roc, tag.data()) ||
+            CRYPTO_memcmp(tag.data(), pkt.buffer.data() + authPortion.size(), tagSize) != 0)
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+
+        m_streams[ssrc].rtpRx.Accept(index);
+        pkt.size = authPortion.size();
+
+        size_t cipherSize{ pkt.size - *headerSize };
+        size_t ksOffset{ QueueCounterBlocks(CmIv(m_rtpKeys.salt, ssrc, index), cipherSize) };
+        m_jobs.push_back(CmJob{ i, *headerSize, cipherSize, ksOffset, index });
+        pkt.status = SrtpStatus::Ok;
+    }
+
+    bool keystreamOk{ RunKeystream(m_rtpKeys) };
+
+    for (const auto& job : m_jobs)
+    {
+        auto& pkt{ pkts[job.pktIdx] };
+        if (!keystreamOk)
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+        XorKeystream(pkt.buffer.subspan(job.cipherOffset, job.cipherSize), job.ksOffset);
+    }
+
+    return CountOk(pkts);
+}
+
+size_t SrtpSession::ProtectRtcpCm(std::span<SrtpPacket> pkts)
+{
+    size_t tagSize{ SrtpTagSize(m_profile) };
+    m_keystream.clear();
+    m_jobs.clear();
+
+    for (size_t i{ 0 }; i < pkts.size(); ++i)
+    {
+        auto& pkt{ pkts[i] };
+        if (pkt.size > pkt.buffer.size() || pkt.size < s_srtcpClearSize)
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+        if (pkt.buffer.size() - pkt.size < SrtpRtcpOverhead(m_profile))
+        {
+            pkt.status = SrtpStatus::NoRoom;
+            continue;
+        }
+
+        uint32_t ssrc{ LoadBe32(pkt.buffer.data() + 4) };
+        auto& stream{ TxStream(ssrc) };
+        uint32_t index{ stream.rtcpTxIndex };
+        stream.rtcpTxIndex = (index + 1) & s_srtcpIndexMask;
+
+        size_t cipherSize{ pkt.size - s_srtcpClearSize };
+        size_t ksOffset{ QueueCounterBlocks(CmIv(m_rtcpKeys.salt, ssrc, index), cipherSize) };
+        m_jobs.push_back(CmJob{ i, s_srtcpClearSize, cipherSize, ksOffset, index });
+        pkt.status = SrtpStatus::Ok;
+    }
+
+    bool keystreamOk{ RunKeystream(m_rtcpKeys) };
+
+    for (const auto& job : m_jobs)
+    {
+        auto& pkt{ pkts[job.pktIdx] };
+        if (!keystreamOk)
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+
+        XorKeystream(pkt.buffer.subspan(job.cipherOffset, job.cipherSize), job.ksOffset);
+
+        // rfc3711#section-3.4, E flag and index are authenticated along with the packet
+        StoreBe32(pkt.buffer.data() + pkt.size, s_srtcpEncryptedFlag | static_cast<uint32_t>(job.index));
+        pkt.size += sizeof(uint32_t);
+        if (!CmTag(m_rtcpKeys, pkt.buffer.first(pkt.size), {}, pkt.buffer.data() + pkt.size))
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+        pkt.size += tagSize;
+    }
+
+    return CountOk(pkts);
+}
+
+size_t SrtpSession::UnprotectRtcpCm(std::span<SrtpPacket> pkts)
+{
+    size_t tagSize{ SrtpTagSize(m_profile) };
+    m_keystream.clear();
+    m_jobs.clear();
+
+    for (size_t i{ 0 }; i < pkts.size(); ++i)
+    {
+        auto& pkt{ pkts[i] };
+        if (pkt.size > pkt.buffer.size() || pkt.size < s_srtcpClearSize + SrtpRtcpOverhead(m_profile))
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+
+        auto authPortion{ pkt.buffer.first(pkt.size - tagSize) };
+        uint32_t eIndex{ LoadBe32(authPortion.data() + authPortion.size() - sizeof(uint32_t)) };
+        uint32_t index{ eIndex & s_srtcpIndexMask };
+        uint32_t ssrc{ LoadBe32(pkt.buffer.data() + 4) };
+
+        const auto* stream{ RxStream(ssrc) };
+        if (stream != nullptr && !stream->rtcpRx.Check(index))
+        {
+            pkt.status = SrtpStatus::Replayed;
+            continue;
+        }
+
+        std::array<uint8_t, s_hmacSha1Size> tag{};
+        if (!CmTag(m_rtcpKeys, authPortion, {}, tag.data()) ||
+            CRYPTO_memcmp(tag.data(), pkt.buffer.data() + authPortion.size(), tagSize) != 0)
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+
+        m_streams[ssrc].rtcpRx.Accept(index);
+        pkt.size = authPortion.size() - sizeof(uint32_t);
+        pkt.status = SrtpStatus::Ok;
+
+        if ((eIndex & s_srtcpEncryptedFlag) != 0)
+        {
+            size_t cipherSize{ pkt.size - s_srtcpClearSize };
+            size_t ksOffset{ QueueCounterBlocks(CmIv(m_rtcpKeys.salt, ssrc, index), cipherSize) };
+            m_jobs.push_back(CmJob{ i, s_srtcpClearSize, cipherSize, ksOffset, index });
+        }
+    }
+
+    bool keystreamOk{ RunKeystream(m_rtcpKeys) };
+
+    for (const auto& job : m_jobs)
+    {
+        auto& pkt{ pkts[job.pktIdx] };
+        if (!keystreamOk)
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+        XorKeystream(pkt.buffer.subspan(job.cipherOffset, job.cipherSize), job.ksOffset);
+    }
+
+    return CountOk(pkts);
+}
+
+size_t SrtpSession::ProtectRtpGcm(std::span<SrtpPacket> pkts)
+{
+    size_t tagSize{ SrtpTagSize(m_profile) };
+    for (auto& pkt : pkts)
+    {
+        auto headerSize{ pkt.size <= pkt.buffer.size() ? RtpHeaderSize(pkt.buffer.first(pkt.size)) : std::nullopt };
+        if (!headerSize)
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+        if (pkt.buffer.size() - pkt.size < tagSize)
+        {
+            pkt.status = SrtpStatus::NoRoom;
+            continue;
+        }
+
+        auto [ssrc, seq]{ RtpSsrcSeq(pkt.buffer) };
+        auto& stream{ TxStream(ssrc) };
+        uint64_t index{ NextTxIndex(stream.rtpTxIndex, stream.rtpTxStarted, seq) };
+
+        // rfc7714#section-8.2, the header is the associated data
+        bool ok{ GcmSeal(
+            m_rtpKeys,
+            GcmIv(m_rtpKeys.salt, ssrc, index),
+            pkt.buffer.first(*headerSize),
+            {},
+            pkt.buffer.subspan(*headerSize, pkt.size - *headerSize),
+            pkt.buffer.data() + pkt.size
+        ) };
+        pkt.status = ok ? SrtpStatus::Ok : SrtpStatus::AuthFailed;
+        pkt.size += ok ? tagSize : 0;
+    }
+
+    return CountOk(pkts);
+}
+
+size_t SrtpSession::UnprotectRtpGcm(std::span<SrtpPacket> pkts)
+{
+    size_t tagSize{ SrtpTagSize(m_profile) };
+    for (auto& pkt : pkts)
+    {
+        if (pkt.size > pkt.buffer.size() || pkt.size < tagSize)
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+
+        size_t cipherEnd{ pkt.size - tagSize };
+        auto headerSize{ RtpHeaderSize(pkt.buffer.first(cipherEnd)) };
+        if (!headerSize)
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+
+        auto [ssrc, seq]{ RtpSsrcSeq(pkt.buffer) };
+        const auto* stream{ RxStream(ssrc) };
+        uint64_t index{ stream != nullptr ? EstimateIndex(stream->rtpRx.MaxIndex(), seq) : seq };
+        if (stream != nullptr && !stream->rtpRx.Check(index))
+        {
+            pkt.status = SrtpStatus::Replayed;
+            continue;
+        }
+
+        if (!GcmOpen(
+                m_rtpKeys,
+                GcmIv(m_rtpKeys.salt, ssrc, index),
+                pkt.buffer.first(*headerSize),
+                {},
+                pkt.buffer.subspan(*headerSize, cipherEnd - *headerSize),
+                pkt.buffer.data() + cipherEnd
+            ))
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+
+        m_streams[ssrc].rtpRx.Accept(index);
+        pkt.size = cipherEnd;
+        pkt.status = SrtpStatus::Ok;
+    }
+
+    return CountOk(pkts);
+}
+
+size_t SrtpSession::ProtectRtcpGcm(std::span<SrtpPacket> pkts)
+{
+    size_t tagSize{ SrtpTagSize(m_profile) };
+    for (auto& pkt : pkts)
+    {
+        if (pkt.size > pkt.buffer.size() || pkt.size < s_srtcpClearSize)
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+        if (pkt.buffer.size() - pkt.size < SrtpRtcpOverhead(m_profile))
+        {
+            pkt.status = SrtpStatus::NoRoom;
+            continue;
+        }
+
+        uint32_t ssrc{ LoadBe32(pkt.buffer.data() + 4) };
+        auto& stream{ TxStream(ssrc) };
+        uint32_t index{ stream.rtcpTxIndex };
+        stream.rtcpTxIndex = (index + 1) & s_srtcpIndexMask;
+
+        // rfc7714#section-9.2: header and SSRC, then E flag and index are the associated data,
+        // the trailer is tag first and E flag with index last
+        std::array<uint8_t, sizeof(uint32_t)> eIndex{};
+        StoreBe32(eIndex.data(), s_srtcpEncryptedFlag | index);
+        bool ok{ GcmSeal(
+            m_rtcpKeys,
+            GcmIv(m_rtcpKeys.salt, ssrc, index),
+            pkt.buffer.first(s_srtcpClearSize),
+            eIndex,
+            pkt.buffer.subspan(s_srtcpClearSize, pkt.size - s_srtcpClearSize),
+            pkt.buffer.data() + pkt.size
+        ) };
+        if (!ok)
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+
+        std::memcpy(pkt.buffer.data() + pkt.size + tagSize, eIndex.data(), eIndex.size());
+        pkt.size += SrtpRtcpOverhead(m_profile);
+        pkt.status = SrtpStatus::Ok;
+    }
+
+    return CountOk(pkts);
+}
+
+size_t SrtpSession::UnprotectRtcpGcm(std::span<SrtpPacket> pkts)
+{
+    for (auto& pkt : pkts)
+    {
+        if (pkt.size > pkt.buffer.size() || pkt.size < s_srtcpClearSize + SrtpRtcpOverhead(m_profile))
+        {
+            pkt.status = SrtpStatus::Malformed;
+            continue;
+        }
+
+        size_t cipherEnd{ pkt.size - SrtpRtcpOverhead(m_profile) };
+        auto eIndex{ pkt.buffer.subspan(pkt.size - sizeof(uint32_t), sizeof(uint32_t)) };
+        uint32_t eIndexVal{ LoadBe32(eIndex.data()) };
+        uint32_t index{ eIndexVal & s_srtcpIndexMask };
+        uint32_t ssrc{ LoadBe32(pkt.buffer.data() + 4) };
+
+        const auto* stream{ RxStream(ssrc) };
+        if (stream != nullptr && !stream->rtcpRx.Check(index))
+        {
+            pkt.status = SrtpStatus::Replayed;
+            continue;
+        }
+
+        // rfc7714#section-9.3, without the E flag the whole packet is associated data and nothing is encrypted
+        bool encrypted{ (eIndexVal & s_srtcpEncryptedFlag) != 0 };
+        size_t aadSize{ encrypted ? s_srtcpClearSize : cipherEnd };
+        if (!GcmOpen(
+                m_rtcpKeys,
+                GcmIv(m_rtcpKeys.salt, ssrc, index),
+                pkt.buffer.first(aadSize),
+                eIndex,
+                pkt.buffer.subspan(aadSize, cipherEnd - aadSize),
+                pkt.buffer.data() + cipherEnd
+            ))
+        {
+            pkt.status = SrtpStatus::AuthFailed;
+            continue;
+        }
+
+        m_streams[ssrc].rtcpRx.Accept(index);
+        pkt.size = cipherEnd;
+        pkt.status = SrtpStatus::Ok;
+    }
+
+    return CountOk(pkts);
+}
+
+} // namespace rtp
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <openssl/types.h>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace rtp
+{
+
+// DTLS-SRTP protection profiles, rfc5764#section-4.1.2 and rfc7714#section-14.2
+enum class SrtpProfile : uint8_t
+{
+    Aes128CmHmacSha1_80, // SRTP_AES128_CM_HMAC_SHA1_80, rfc3711
+    AeadAes128Gcm,       // SRTP_AEAD_AES_128_GCM, rfc7714
+};
+
+constexpr size_t s_srtpMasterKeySize{ 16 };
+
+constexpr size_t SrtpMasterSaltSize(SrtpProfile profile)
+{
+    return profile == SrtpProfile::AeadAes128Gcm ? 12 : 14;
+}
+
+constexpr size_t SrtpTagSize(SrtpProfile profile)
+{
+    return profile == SrtpProfile::AeadAes128Gcm ? 16 : 10;
+}
+
+// Bytes protecting an RTP packet appends, the buffer needs this much room past the packet
+constexpr size_t SrtpRtpOverhead(SrtpProfile profile)
+{
+    return SrtpTagSize(profile);
+}
+
+// Bytes protecting an RTCP packet appends: the tag and the E flag with the SRTCP index
+constexpr size_t SrtpRtcpOverhead(SrtpProfile profile)
+{
+    return SrtpTagSize(profile) + sizeof(uint32_t);
+}
+
+enum class SrtpStatus : uint8_t
+{
+    Ok,
+    Malformed,  // too short for its headers, or for the trailer when unprotecting
+    NoRoom,     // no room past the packet for the trailer
+    AuthFailed, // tag mismatch, or the cipher could not run
+    Replayed,   // index already seen or behind the replay window
+};
+
+// One packet of a batch call. size is updated and status filled in by the call.
+struct SrtpPacket
+{
+    // whole buffer, the packet being its first size bytes
+    std::span<uint8_t> buffer;
+    size_t size;
+    SrtpStatus status{ SrtpStatus::Ok };
+};
+
+/**
+rfc3711#section-3.3.2 replay list as a sliding 64 entry bitmask.
+
+Check before authenticating, Accept only once the packet authenticated, so forged packets cannot move the window.
+*/
+
+class SrtpReplayWindow
+{
+public:
+    static constexpr uint64_t s_size{ 64 };
+
+    bool Check(uint64_t index) const
+    {
+        if (!m_started || index > m_maxIndex)
+        {
+            return true;
+        }
+
+        uint64_t delta{ m_maxIndex - index };
+        return delta < s_size && (m_mask & (uint64_t{ 1 } << delta)) == 0;
+    }
+
+    void Accept(uint64_t index)
+    {
+        if (!m_started)
+        {
+            m_started = true;
+            m_maxIndex = index;
+            m_mask = 1;
+        }
+        else if (index > m_maxIndex)
+        {
+            uint64_t shift{ index - m_maxIndex };
+            m_mask = shift < s_size ? (m_mask << shift) | 1 : 1;
+            m_maxIndex = index;
+        }
+        else
+        {
+            m_mask |= uint64_t{ 1 } << (m_maxIndex - index);
+        }
+    }
+
+    bool Started() const { return m_started; }
+
+    uint64_t MaxIndex() const { return m_maxIndex; }
+
+private:
+    uint64_t m_maxIndex{ 0 };
+    uint64_t m_mask{ 0 };
+    bool m_started{ false };
+};
+
+/**
+SRTP and SRTCP protect/unprotect for one direction of a DTLS-SRTP association, rfc3711 and rfc7714.
+
+Everything happens in place: protecting encrypts the payload where it lies and appends the trailer into the room past
+the packet, unprotecting decrypts where it lies and shrinks the size, so the packet goes straight on to ParseRtp or
+ParseRtcp. Rollover counters, SRTCP indices and replay windows are kept per SSRC, and an unprotected packet only
+creates or advances its SSRC's state once it authenticated. Session keys are derived once at creation (key derivation
+rate 0) and the cipher and MAC contexts are keyed once, a packet only sets its IV.
+
+The batch calls are the fast path. With AES-CM the counter blocks of every packet are laid out back to back and
+encrypted in one AES-ECB pass, so blocks of different packets keep the AES-NI pipeline full even for short audio
+payloads, then each packet is XORed and run through HMAC-SHA1. With AES-GCM the packets go one by one through a context
+whose key schedule and GHASH key are set up once, OpenSSL interleaves the AES-NI and PCLMUL work within each packet.
+
+A packet that fails to unprotect must be dropped, with AES-GCM its payload may already be decrypted. A session is not
+thread safe, use one per worker or shard.
+*/
+
+class SrtpSession
+{
+public:
+    // std::nullopt if the key or salt size does not match the profile or OpenSSL cannot set up the ciphers
+    static std::optional<SrtpSession> Create(
+        SrtpProfile profile, std::span<const uint8_t> masterKey, std::span<const uint8_t> masterSalt
+    );
+
+    SrtpStatus ProtectRtp(std::span<uint8_t> buffer, size_t& size);
+
+    SrtpStatus UnprotectRtp(std::span<uint8_t> buffer, size_t& size);
+
+    SrtpStatus ProtectRtcp(std::span<uint8_t> buffer, size_t& size);
+
+    SrtpStatus UnprotectRtcp(std::span<uint8_t> buffer, size_t& size);
+
+    // Batch forms, each returns the number of packets that came out Ok
+    size_t ProtectRtp(std::span<SrtpPacket> pkts);
+
+    size_t UnprotectRtp(std::span<SrtpPacket> pkts);
+
+    size_t ProtectRtcp(std::span<SrtpPacket> pkts);
+
+    size_t UnprotectRtcp(std::span<SrtpPacket> pkts);
+
+    SrtpProfile Profile() const { return m_profile; }
+
+private:
+    struct CipherCtxFree
+    {
+        void operator()(EVP_CIPHER_CTX* ctx) const;
+    };
+
+    struct MacCtxFree
+    {
+        void operator()(EVP_MAC_CTX* ctx) const;
+    };
+
+    using CipherCtxPtr = std::unique_ptr<EVP_CIPHER_CTX, CipherCtxFree>;
+    using MacCtxPtr = std::unique_ptr<EVP_MAC_CTX, MacCtxFree>;
+
+    // Keys of one of the two packet kinds, rfc3711#section-4.3.2 labels 0-2 for RTP, 3-5 for RTCP
+    struct SrtpKeys
+    {
+        // AES-128-ECB keystream generator for AES-CM, AES-128-GCM otherwise
+        CipherCtxPtr cipher;
+        // HMAC-SHA1, AES-CM only
+        MacCtxPtr mac;
+        // 14 bytes for AES-CM, 12 for AES-GCM
+        std::array<uint8_t, 14> salt{};
+    };
+
+    struct SrtpStream
+    {
+        uint64_t rtpTxIndex{ 0 };
+        bool rtpTxStarted{ false };
+        uint32_t rtcpTxIndex{ 0 };
+        SrtpReplayWindow rtpRx;
+        SrtpReplayWindow rtcpRx;
+    };
+
+    // AES-CM packet waiting for its keystream, which starts at ksOffset of m_keystream
+    struct CmJob
+    {
+        size_t pktIdx;
+        size_t cipherOffset;
+        size_t cipherSize;
+        size_t ksOffset;
+        uint64_t index;
+    };
+
+    SrtpSession(SrtpProfile profile, SrtpKeys rtpKeys, SrtpKeys rtcpKeys);
+
+    // Session keys of one packet kind from the rfc3711#section-4.3.3 AES-CM PRF, encryptionLabel being 0 or 3
+    static std::optional<SrtpKeys> DeriveKeys(
+        SrtpProfile profile,
+        std::span<const uint8_t> masterKey,
+        const std::array<uint8_t, 14>& masterSalt,
+        uint8_t encryptionLabel
+    );
+
+    SrtpStream& TxStream(uint32_t ssrc) { return m_streams[ssrc]; }
+
+    // nullptr when the SSRC has not authenticated a packet yet
+    const SrtpStream* RxStream(uint32_t ssrc) const;
+
+    // Appends the counter blocks covering size bytes from the given IV to m_keystream
+    size_t QueueCounterBlocks(const std::array<uint8_t, 16>& iv, size_t size);
+
+    // Encrypts every queued counter block in one pass
+    bool RunKeystream(SrtpKeys& keys);
+
+    void XorKeystream(std::span<uint8_t> data, size_t ksOffset) const;
+
+    // Truncated HMAC-SHA1 over authPortion followed by authTail (the ROC for RTP), written to tag
+    bool CmTag(
+        SrtpKeys& keys, std::span<const uint8_t> authPortion, std::span<const uint8_t> authTail, uint8_t* tag
+    ) const;
+
+    // Encrypts data in place and writes the tag, aad and aadTail are authenticated only
+    static bool GcmSeal(
+        SrtpKeys& keys,
+        const std::array<uint8_t, 12>& iv,
+        std::span<const uint8_t> aad,
+        std::span<const uint8_t> aadTail,
+        std::span<uint8_t> data,
+        uint8_t* tag
+    );
+
+    // Decrypts data in place, false when the tag does not match
+    static bool GcmOpen(
+        SrtpKeys& keys,
+        const std::array<uint8_t, 12>& iv,
+        std::span<const uint8_t> aad,
+        std::span<const uint8_t> aadTail,
+        std::span<uint8_t> data,
+        const uint8_t* tag
+    );
+
+    size_t ProtectRtpCm(std::span<SrtpPacket> pkts);
+    size_t UnprotectRtpCm(std::span<SrtpPacket> pkts);
+    size_t ProtectRtcpCm(std::span<SrtpPacket> pkts);
+    size_t UnprotectRtcpCm(std::span<SrtpPacket> pkts);
+    size_t ProtectRtpGcm(std::span<SrtpPacket> pkts);
+    size_t UnprotectRtpGcm(std::span<SrtpPacket> pkts);
+    size_t ProtectRtcpGcm(std::span<SrtpPacket> pkts);
+    size_t UnprotectRtcpGcm(std::span<SrtpPacket> pkts);
+
+    SrtpProfile m_profile;
+    SrtpKeys m_rtpKeys;
+    SrtpKeys m_rtcpKeys;
+    std::unordered_map<uint32_t, SrtpStream> m_streams;
+    // batch scratch, kept to avoid allocating per call
+    std::vector<uint8_t> m_keystream;
+    std::vector<CmJob> m_jobs;
+};
+
+} // namespace rtp